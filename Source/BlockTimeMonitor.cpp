@@ -0,0 +1,239 @@
+/*
+  ==============================================================================
+
+    BlockTimeMonitor.cpp
+    Created: 19 Oct 2026
+    Author:  woz
+
+  ==============================================================================
+*/
+
+#include "BlockTimeMonitor.h"
+
+BlockTimeMonitor::BlockTimeMonitor(const juce::Array<juce::AudioProcessorParameter*>& p)
+    : juce::Thread("SympleSynth block timing"), parameters(p)
+{
+    for (auto& bin : histogram)
+        bin = 0;
+
+    // the tree has added every parameter by now and never adds more
+    previousValues.calloc((size_t)juce::jmax(1, parameters.size()));
+    currentValues.calloc((size_t)juce::jmax(1, parameters.size()));
+
+    xruns.reserve(maxKeptXruns);
+}
+
+BlockTimeMonitor::~BlockTimeMonitor()
+{
+    stopDumping();
+}
+
+void BlockTimeMonitor::startDumping(const juce::File& file, int intervalSeconds)
+{
+    stopDumping();
+
+    deleteOldDumps(file.getParentDirectory());
+
+    dumpFile = file;
+    dumpIntervalMs = juce::jmax(1, intervalSeconds) * 1000;
+    startThread();
+}
+
+void BlockTimeMonitor::stopDumping()
+{
+    if (dumpFile == juce::File())
+        return;
+
+    signalThreadShouldExit();
+    notify();
+    stopThread(2000);
+
+    collectXruns();
+    writeDump();
+    dumpFile = juce::File();
+}
+
+/* Keeps room for one more dump next to the newest maxKeptDumps - 1 */
+void BlockTimeMonitor::deleteOldDumps(const juce::File& folder)
+{
+    auto dumps = folder.findChildFiles(juce::File::findFiles, false, "BlockTiming-*.json");
+
+    std::sort(dumps.begin(), dumps.end(), [] (const juce::File& a, const juce::File& b)
+    {
+        return a.getLastModificationTime() < b.getLastModificationTime();
+    });
+
+    for (int i = 0; i < dumps.size() - (maxKeptDumps - 1); ++i)
+        dumps.getReference(i).deleteFile();
+}
+
+juce::File BlockTimeMonitor::getDefaultDumpFile()
+{
+    return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+        .getChildFile("SympleSynth")
+        .getChildFile("BlockTiming")
+        .getNonexistentChildFile("BlockTiming-" + juce::Time::getCurrentTime().formatted("%Y%m%d-%H%M%S"), ".json");
+}
+
+void BlockTimeMonitor::beginBlock(int numSamples, double sampleRate) noexcept
+{
+    previousValues.swapWith(currentValues);
+    for (int index = 0; index < parameters.size(); ++index)
+        currentValues[index] = parameters.getUnchecked(index)->getValue();
+
+    blockSamples = numSamples;
+    deadlineSeconds = sampleRate > 0.0 ? numSamples / sampleRate : 0.0;
+    blockStartTicks = juce::Time::getHighResolutionTicks();
+}
+
+void BlockTimeMonitor::endBlock(const BlockContext& context) noexcept
+{
+    const double seconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - blockStartTicks);
+    const float load = deadlineSeconds > 0.0 ? (float)(seconds / deadlineSeconds) : 0.0f;
+    const auto blockIndex = numBlocks.load(std::memory_order_relaxed);
+    lastLoad = load;
+
+    const int bin = juce::jlimit(0, numHistogramBins, (int)(load / histogramBinWidth));
+    histogram[(size_t)bin].store(histogram[(size_t)bin].load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    numBlocks.store(blockIndex + 1, std::memory_order_relaxed);
+
+    if (load > worstLoad.load(std::memory_order_relaxed))
+        worstLoad.store(load, std::memory_order_relaxed);
+
+    if (load <= 1.0f)
+        return;
+
+    numOverBudget.store(numOverBudget.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+    int start1, size1, start2, size2;
+    fifo.prepareToWrite(1, start1, size1, start2, size2);
+
+    // the background thread is behind, the block still counts in the histogram
+    if (size1 == 0)
+        return;
+
+    auto& record = pending[(size_t)start1];
+    record.blockIndex = blockIndex;
+    record.sessionSeconds = (juce::Time::getMillisecondCounterHiRes() - sessionStartMs) * 0.001;
+    record.load = load;
+    record.numSamples = blockSamples;
+    record.context = context;
+    record.numChangedParameters = 0;
+
+    // the first block has nothing to compare against
+    if (blockIndex > 0)
+    {
+        for (int index = 0; index < parameters.size(); ++index)
+        {
+            if (currentValues[index] != previousValues[index])
+            {
+                if (record.numChangedParameters < maxChangedParameters)
+                    record.changedParameters[(size_t)record.numChangedParameters] = (juce::uint16)index;
+                ++record.numChangedParameters;
+            }
+        }
+    }
+
+    fifo.finishedWrite(1);
+}
+
+void BlockTimeMonitor::run()
+{
+    while (!threadShouldExit())
+    {
+        // drain often so the fifo never fills, write out less often
+        for (int waited = 0; waited < dumpIntervalMs && !threadShouldExit(); waited += 250)
+        {
+            collectXruns();
+            wait(250);
+        }
+
+        // stopDumping() writes the last one once the thread has gone
+        if (!threadShouldExit())
+        {
+            collectXruns();
+            writeDump();
+        }
+    }
+}
+
+void BlockTimeMonitor::collectXruns()
+{
+    int start1, size1, start2, size2;
+    fifo.prepareToRead(fifo.getNumReady(), start1, size1, start2, size2);
+
+    auto keep = [this] (const XrunRecord& record)
+    {
+        if ((int)xruns.size() == maxKeptXruns)
+            xruns.erase(xruns.begin());
+        xruns.push_back(record);
+    };
+
+    for (int i = 0; i < size1; ++i)
+        keep(pending[(size_t)(start1 + i)]);
+    for (int i = 0; i < size2; ++i)
+        keep(pending[(size_t)(start2 + i)]);
+
+    fifo.finishedRead(size1 + size2);
+}
+
+juce::var BlockTimeMonitor::toVar(const XrunRecord& record) const
+{
+    juce::Array<juce::var> changed;
+    for (int i = 0; i < juce::jmin(record.numChangedParameters, maxChangedParameters); ++i)
+    {
+        auto* parameter = parameters[(int)record.changedParameters[(size_t)i]];
+        if (auto* ranged = dynamic_cast<juce::RangedAudioParameter*>(parameter))
+            changed.add(ranged->paramID);
+        else
+            changed.add((int)record.changedParameters[(size_t)i]);
+    }
+
+    auto* object = new juce::DynamicObject();
+    object->setProperty("block", record.blockIndex);
+    object->setProperty("seconds", record.sessionSeconds);
+    object->setProperty("load", record.load);
+    object->setProperty("samples", record.numSamples);
+    object->setProperty("voices", record.context.activeVoices);
+    object->setProperty("midiEvents", record.context.midiEvents);
+    object->setProperty("filter1Mode", record.context.filter1Mode);
+    object->setProperty("filter2Mode", record.context.filter2Mode);
+    object->setProperty("governorLevel", record.context.governorLevel);
+    object->setProperty("changedParameters", changed);
+    object->setProperty("numChangedParameters", record.numChangedParameters);
+    return juce::var(object);
+}
+
+void BlockTimeMonitor::writeDump()
+{
+    const auto blocks = numBlocks.load();
+
+    // nothing played since the last write
+    if (blocks == blocksAtLastDump)
+        return;
+
+    blocksAtLastDump = blocks;
+
+    juce::Array<juce::var> counts;
+    for (auto& bin : histogram)
+        counts.add((int)bin.load());
+
+    auto* histogramObject = new juce::DynamicObject();
+    histogramObject->setProperty("binWidth", histogramBinWidth);
+    histogramObject->setProperty("counts", counts);
+
+    juce::Array<juce::var> xrunList;
+    for (auto& record : xruns)
+        xrunList.add(toVar(record));
+
+    auto* report = new juce::DynamicObject();
+    report->setProperty("sessionSeconds", (juce::Time::getMillisecondCounterHiRes() - sessionStartMs) * 0.001);
+    report->setProperty("blocks", blocks);
+    report->setProperty("overBudget", numOverBudget.load());
+    report->setProperty("worstLoad", worstLoad.load());
+    report->setProperty("histogram", juce::var(histogramObject));
+    report->setProperty("xruns", xrunList);
+
+    dumpFile.getParentDirectory().createDirectory();
+    dumpFile.replaceWithText(juce::JSON::toString(juce::var(report)));
+}
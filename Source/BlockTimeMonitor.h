@@ -0,0 +1,117 @@
+/*
+  ==============================================================================
+
+    BlockTimeMonitor.h
+    Created: 19 Oct 2026
+    Author:  woz
+    Notes: Keeps a histogram of how much of its deadline (numSamples /
+           sampleRate) every processBlock used, and a log of the blocks that
+           went over it, tagged with what was going on at the time.
+
+           Everything the audio thread touches is allocated up front. The
+           histogram is a fixed array of atomic counters and over budget
+           blocks are passed through a wait-free fifo to a background thread,
+           which keeps the most recent ones and writes everything to a json
+           file every so often.
+
+           The plugin only writes the json when built with
+           SYMPLE_BLOCK_TIMING_DUMPS=1, one file per session of which the
+           newest maxKeptDumps are kept. The histogram and load are always
+           kept, the CPU governor runs on them.
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+#ifndef SYMPLE_BLOCK_TIMING_DUMPS
+ #define SYMPLE_BLOCK_TIMING_DUMPS 0
+#endif
+
+class BlockTimeMonitor : private juce::Thread
+{
+public:
+    static constexpr int numHistogramBins = 40;
+    static constexpr float histogramBinWidth = 0.05f; // of the deadline, the last bin holds everything above 2
+    static constexpr int maxChangedParameters = 16;
+    static constexpr int maxKeptDumps = 20;
+
+    /* What the processor was doing during a block */
+    struct BlockContext
+    {
+        int activeVoices = 0;
+        int midiEvents = 0;
+        int filter1Mode = 0;
+        int filter2Mode = 0;
+        int governorLevel = 0;
+    };
+
+    explicit BlockTimeMonitor(const juce::Array<juce::AudioProcessorParameter*>& parameters);
+    ~BlockTimeMonitor() override;
+
+    /* Starts the background thread writing to the file, and deletes the
+       oldest dumps in its folder over maxKeptDumps. Message thread only */
+    void startDumping(const juce::File& file, int intervalSeconds = 30);
+
+    /* Stops the background thread and writes what came in since the last dump */
+    void stopDumping();
+
+    /* A new file in the user's application data folder for this session */
+    static juce::File getDefaultDumpFile();
+
+    //==============================================================================
+    // audio thread
+
+    void beginBlock(int numSamples, double sampleRate) noexcept;
+    void endBlock(const BlockContext& context) noexcept;
+
+    /* The fraction of its deadline the last block used */
+    float getLastLoad() const noexcept { return lastLoad; }
+
+private:
+    struct XrunRecord
+    {
+        juce::int64 blockIndex = 0;
+        double sessionSeconds = 0.0;
+        float load = 0.0f;
+        int numSamples = 0;
+        BlockContext context;
+        std::array<juce::uint16, maxChangedParameters> changedParameters {};
+        int numChangedParameters = 0; // can be more than were stored
+    };
+
+    const juce::Array<juce::AudioProcessorParameter*>& parameters;
+
+    // written by the audio thread only
+    std::array<std::atomic<juce::uint32>, numHistogramBins + 1> histogram;
+    std::atomic<juce::int64> numBlocks { 0 };
+    std::atomic<juce::int64> numOverBudget { 0 };
+    std::atomic<float> worstLoad { 0.0f };
+
+    juce::HeapBlock<float> previousValues, currentValues;
+    juce::int64 blockStartTicks = 0;
+    double deadlineSeconds = 0.0;
+    int blockSamples = 0;
+    float lastLoad = 0.0f;
+    const double sessionStartMs = juce::Time::getMillisecondCounterHiRes();
+
+    static constexpr int fifoSize = 128;
+    juce::AbstractFifo fifo { fifoSize };
+    std::array<XrunRecord, fifoSize> pending;
+
+    // owned by the background thread
+    static constexpr int maxKeptXruns = 1000;
+    std::vector<XrunRecord> xruns;
+    juce::File dumpFile;
+    int dumpIntervalMs = 30000;
+    juce::int64 blocksAtLastDump = -1;
+
+    void run() override;
+    void collectXruns();
+    void writeDump();
+    static void deleteOldDumps(const juce::File& folder);
+    juce::var toVar(const XrunRecord&) const;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BlockTimeMonitor)
+};
@@ -0,0 +1,101 @@
+/*
+  ==============================================================================
+
+    Chorus.cpp
+    Created: 19 Oct 2026
+    Author:  woz
+
+  ==============================================================================
+*/
+
+#include "Chorus.h"
+
+void Chorus::prepare(double newSampleRate, int newNumChannels)
+{
+    sampleRate = newSampleRate;
+    numChannels = juce::jmin(newNumChannels, maxChannels);
+
+    const int maxDelay = (int)std::ceil((baseDelayTime + maxDepthTime) * sampleRate);
+    for (auto& line : lines)
+        line.prepare(maxDelay);
+
+    reset();
+}
+
+void Chorus::reset()
+{
+    for (auto& line : lines)
+        line.reset();
+
+    phase = 0.0;
+
+    for (int channel = 0; channel < maxChannels; ++channel)
+        for (int t = 0; t < numTaps; ++t)
+            tapDelay[channel][t] = getTapDelay(channel, t);
+}
+
+void Chorus::setParameters(float newRate, float newDepth, float newMix)
+{
+    rate = newRate;
+    depth = juce::jlimit(0.0f, 1.0f, newDepth);
+    mix = juce::jlimit(0.0f, 1.0f, newMix);
+}
+
+float Chorus::getTapDelay(int channel, int tapIndex) const
+{
+    const double tapPhase = phase + tapIndex / (double)numTaps + channel * 0.25;
+    const float lfo = (float)std::sin(juce::MathConstants<double>::twoPi * tapPhase);
+    const float delayTime = baseDelayTime + depth * maxDepthTime * lfo;
+
+    return juce::jmax(ModulatedDelay::getMinimumDelay(), delayTime * (float)sampleRate);
+}
+
+void Chorus::process(juce::AudioBuffer<float>& buffer, int numSamples)
+{
+    const int channels = juce::jmin(numChannels, buffer.getNumChannels());
+
+    // off: keep the lines filled so switching on doesn't play stale audio
+    if (mix <= 0.0f)
+    {
+        for (int channel = 0; channel < channels; ++channel)
+            lines[channel].write(buffer.getReadPointer(channel), numSamples);
+
+        return;
+    }
+
+    for (int start = 0; start < numSamples; start += ModulatedDelay::maxChunk)
+    {
+        const int n = juce::jmin(ModulatedDelay::maxChunk, numSamples - start);
+
+        // one LFO step per chunk
+        phase += rate * n / sampleRate;
+        phase -= std::floor(phase);
+
+        for (int channel = 0; channel < channels; ++channel)
+        {
+            float* samples = buffer.getWritePointer(channel, start);
+            auto& line = lines[channel];
+
+            juce::FloatVectorOperations::clear(wet, n);
+
+            for (int t = 0; t < numTaps; ++t)
+            {
+                const float from = tapDelay[channel][t];
+                const float to = getTapDelay(channel, t);
+                const float step = (to - from) / n;
+
+                for (int i = 0; i < n; ++i)
+                    delays[i] = from + step * (i + 1);
+
+                line.read(delays, tap, n);
+                juce::FloatVectorOperations::add(wet, tap, n);
+                tapDelay[channel][t] = to;
+            }
+
+            line.write(samples, n);
+
+            juce::FloatVectorOperations::multiply(samples, 1.0f - mix, n);
+            juce::FloatVectorOperations::addWithMultiply(samples, wet, mix / numTaps, n);
+        }
+    }
+}
@@ -0,0 +1,56 @@
+/*
+  ==============================================================================
+
+    Chorus.h
+    Created: 19 Oct 2026
+    Author:  woz
+    Notes: Three voice ensemble chorus on the voice mix. Each channel has one
+           ModulatedDelay read by three taps whose sine LFOs are a third of a
+           cycle apart. The right channel's LFOs are a further quarter cycle
+           along, which is what spreads it in stereo.
+
+           The LFOs run at control rate, one step per ModulatedDelay chunk,
+           and the delay of each tap is ramped linearly across the chunk.
+
+  ==============================================================================
+*/
+
+#pragma once
+#include "ModulatedDelay.h"
+
+class Chorus
+{
+public:
+    static constexpr int maxChannels = 2;
+    static constexpr int numTaps = 3;
+
+    /* Allocates the delay lines. Not realtime safe */
+    void prepare(double sampleRate, int numChannels);
+    void reset();
+
+    /* rate in Hz, depth and mix from 0 to 1 */
+    void setParameters(float rate, float depth, float mix);
+
+    /* Processes the first numSamples of buffer in place */
+    void process(juce::AudioBuffer<float>& buffer, int numSamples);
+
+private:
+    static constexpr float baseDelayTime = 0.012f;
+    static constexpr float maxDepthTime = 0.005f;
+
+    double sampleRate = 44100.0;
+    int numChannels = 0;
+    float rate = 0.6f;
+    float depth = 0.5f;
+    float mix = 0.0f;
+
+    ModulatedDelay lines[maxChannels];
+    double phase = 0.0;
+    float tapDelay[maxChannels][numTaps] = {};
+
+    float delays[ModulatedDelay::maxChunk];
+    float tap[ModulatedDelay::maxChunk];
+    float wet[ModulatedDelay::maxChunk];
+
+    float getTapDelay(int channel, int tapIndex) const;
+};
@@ -0,0 +1,611 @@
+/*
+  ==============================================================================
+
+    ConvolutionReverb.cpp
+    Created: 19 Oct 2026
+    Author:  woz
+
+  ==============================================================================
+*/
+
+#include "ConvolutionReverb.h"
+
+/*
+ *  Convolves one channel with an impulse response cut into partitions of
+ *  the same size, overlap-save with a frequency domain delay line. The
+ *  spectra are split into real and imaginary arrays so the multiply and
+ *  accumulate loop vectorises.
+ */
+class ConvolutionReverb::PartitionedConvolver
+{
+public:
+    PartitionedConvolver(const float* ir, int irLength, int partitionSize)
+        : size(partitionSize),
+          fftSize(2 * partitionSize),
+          numBins(partitionSize + 1),
+          numPartitions(juce::jmax(1, (irLength + partitionSize - 1) / partitionSize)),
+          fft(juce::findHighestSetBit((juce::uint32)(2 * partitionSize)))
+    {
+        irRe.allocate((size_t)(numPartitions * numBins), true);
+        irIm.allocate((size_t)(numPartitions * numBins), true);
+        fdlRe.allocate((size_t)(numPartitions * numBins), true);
+        fdlIm.allocate((size_t)(numPartitions * numBins), true);
+        window.allocate((size_t)fftSize, true);
+        work.allocate((size_t)(2 * fftSize), true);
+        accumulatorRe.allocate((size_t)numBins, true);
+        accumulatorIm.allocate((size_t)numBins, true);
+
+        for (int partition = 0; partition < numPartitions; ++partition)
+        {
+            const int offset = partition * size;
+            const int length = juce::jmin(size, irLength - offset);
+
+            juce::FloatVectorOperations::clear(work, 2 * fftSize);
+            if (length > 0)
+                juce::FloatVectorOperations::copy(work, ir + offset, length);
+
+            fft.performRealOnlyForwardTransform(work, true);
+            splitSpectrum(irRe + partition * numBins, irIm + partition * numBins);
+        }
+    }
+
+    /* Forgets the input so far, the impulse response is kept */
+    void reset()
+    {
+        juce::FloatVectorOperations::clear(fdlRe, numPartitions * numBins);
+        juce::FloatVectorOperations::clear(fdlIm, numPartitions * numBins);
+        juce::FloatVectorOperations::clear(window, fftSize);
+        position = 0;
+    }
+
+    /* Convolves the next partition of input, nullptr being silence, and
+       writes a partition of output unless output is nullptr */
+    void process(const float* input, float* output)
+    {
+        // the transform sees the previous partition followed by this one
+        juce::FloatVectorOperations::copy(window, window + size, size);
+        if (input != nullptr)
+            juce::FloatVectorOperations::copy(window + size, input, size);
+        else
+            juce::FloatVectorOperations::clear(window + size, size);
+
+        float* slotRe = fdlRe + position * numBins;
+        float* slotIm = fdlIm + position * numBins;
+
+        juce::FloatVectorOperations::copy(work, window, fftSize);
+        juce::FloatVectorOperations::clear(work + fftSize, fftSize);
+        fft.performRealOnlyForwardTransform(work, true);
+        splitSpectrum(slotRe, slotIm);
+
+        if (output != nullptr)
+        {
+            juce::FloatVectorOperations::clear(accumulatorRe, numBins);
+            juce::FloatVectorOperations::clear(accumulatorIm, numBins);
+
+            // the newest input goes with the first partition of the IR
+            int slot = position;
+            for (int partition = 0; partition < numPartitions; ++partition)
+            {
+                multiplyAdd(fdlRe + slot * numBins, fdlIm + slot * numBins,
+                            irRe + partition * numBins, irIm + partition * numBins);
+                slot = slot == 0 ? numPartitions - 1 : slot - 1;
+            }
+
+            for (int bin = 0; bin < numBins; ++bin)
+            {
+                work[2 * bin] = accumulatorRe[bin];
+                work[2 * bin + 1] = accumulatorIm[bin];
+            }
+
+            fft.performRealOnlyInverseTransform(work);
+
+            // only the second half is free of wrap around
+            juce::FloatVectorOperations::copy(output, work + size, size);
+        }
+
+        position = position + 1 == numPartitions ? 0 : position + 1;
+    }
+
+private:
+    const int size;
+    const int fftSize;
+    const int numBins;
+    const int numPartitions;
+    juce::dsp::FFT fft;
+
+    juce::HeapBlock<float> irRe, irIm;      // numPartitions x numBins
+    juce::HeapBlock<float> fdlRe, fdlIm;    // the input spectra, a ring of numPartitions
+    juce::HeapBlock<float> window, work;
+    juce::HeapBlock<float> accumulatorRe, accumulatorIm;
+    int position = 0;
+
+    void splitSpectrum(float* re, float* im) const
+    {
+        for (int bin = 0; bin < numBins; ++bin)
+        {
+            re[bin] = work[2 * bin];
+            im[bin] = work[2 * bin + 1];
+        }
+    }
+
+    void multiplyAdd(const float* xRe, const float* xIm, const float* hRe, const float* hIm)
+    {
+        float* accRe = accumulatorRe;
+        float* accIm = accumulatorIm;
+
+        for (int bin = 0; bin < numBins; ++bin)
+        {
+            accRe[bin] += xRe[bin] * hRe[bin] - xIm[bin] * hIm[bin];
+            accIm[bin] += xRe[bin] * hIm[bin] + xIm[bin] * hRe[bin];
+        }
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (PartitionedConvolver)
+};
+
+/*
+ *  One impulse response with everything needed to run it. Only the audio
+ *  thread touches the head. Tail block k is written to input slot
+ *  k % numTailSlots by the audio thread, and its frame is written to
+ *  output slot (k + 2) % numTailSlots by whichever thread runs the tail.
+ */
+struct ConvolutionReverb::Engine
+{
+    int numChannels = 0;
+    int irLength = 0;
+    bool hasTail = false;
+
+    std::unique_ptr<PartitionedConvolver> head[maxChannels];
+    std::unique_ptr<PartitionedConvolver> tail[maxChannels];
+
+    float headInput[maxChannels][headPartitionSize] {};
+    float wetOutput[maxChannels][headPartitionSize] {};  // plays while the next partition fills
+    int headFill = 0;
+    juce::int64 headPartitions = 0;
+    juce::int64 silentSamples = 0;
+
+    juce::HeapBlock<float> tailInput[maxChannels];
+    juce::HeapBlock<float> tailOutput[maxChannels];
+    bool tailFrameReady = false;
+    std::atomic<juce::int64> tailBlocksSubmitted { 0 };
+    std::atomic<juce::int64> tailBlocksProcessed { 0 };
+};
+
+//==============================================================================
+ConvolutionReverb::ConvolutionReverb()
+    : juce::Thread("SympleSynth reverb")
+{
+}
+
+ConvolutionReverb::~ConvolutionReverb()
+{
+    release();
+}
+
+void ConvolutionReverb::prepare(double newSampleRate, int newNumChannels, float mix)
+{
+    release();
+
+    sampleRate = newSampleRate;
+    numChannels = juce::jlimit(1, maxChannels, newNumChannels);
+    lateTailFrames = 0;
+
+    {
+        const juce::ScopedLock sl (fileLock);
+        builtFile = requestedFile;
+    }
+    builtFileGeneration = requestedFileGeneration.load();
+    builtRoomSize = requestedRoomSize.load();
+
+    engine = buildEngine(builtRoomSize, builtFile).release();
+    activeEngine = engine;
+
+    workerRequested = mix > 0.0f;
+    if (workerRequested)
+        handleAsyncUpdate();
+}
+
+void ConvolutionReverb::release()
+{
+    cancelPendingUpdate();
+    stopWorker();
+    deleteEngines();
+}
+
+/*
+ *  Takes the tail from the worker while it clears, like a synchronous render
+ *  does, so the worker never runs a half cleared delay line
+ */
+void ConvolutionReverb::reset()
+{
+    if (engine == nullptr)
+        return;
+
+    auto& e = *engine;
+
+    while (tailBusy.exchange(true, std::memory_order_acquire))
+        juce::Thread::yield();
+
+    for (int channel = 0; channel < e.numChannels; ++channel)
+    {
+        e.head[channel]->reset();
+        juce::FloatVectorOperations::clear(e.headInput[channel], headPartitionSize);
+        juce::FloatVectorOperations::clear(e.wetOutput[channel], headPartitionSize);
+
+        if (e.hasTail)
+        {
+            e.tail[channel]->reset();
+            juce::FloatVectorOperations::clear(e.tailInput[channel], numTailSlots * tailPartitionSize);
+            juce::FloatVectorOperations::clear(e.tailOutput[channel], numTailSlots * tailPartitionSize);
+        }
+    }
+
+    e.headFill = 0;
+    e.headPartitions = 0;
+    e.silentSamples = 0;
+    e.tailFrameReady = false;
+    e.tailBlocksSubmitted.store(0, std::memory_order_relaxed);
+    e.tailBlocksProcessed.store(0, std::memory_order_relaxed);
+
+    tailBusy.store(false, std::memory_order_release);
+}
+
+void ConvolutionReverb::stopWorker()
+{
+    // the worker only wakes up when it is signalled
+    signalThreadShouldExit();
+    notify();
+    stopThread(2000);
+}
+
+void ConvolutionReverb::handleAsyncUpdate()
+{
+    // the tail has a deadline, so the worker runs just below the audio thread
+    if (activeEngine.load() != nullptr && !isThreadRunning())
+        startThread(8);
+}
+
+void ConvolutionReverb::deleteEngines()
+{
+    activeEngine = nullptr;
+    delete engine;
+    delete pendingEngine.exchange(nullptr);
+    delete retiredEngine.exchange(nullptr);
+    engine = nullptr;
+}
+
+void ConvolutionReverb::loadImpulseResponse(const juce::File& file)
+{
+    {
+        const juce::ScopedLock sl (fileLock);
+        requestedFile = file;
+        ++requestedFileGeneration;
+    }
+
+    notify();
+}
+
+void ConvolutionReverb::setRoomSize(float seconds)
+{
+    const float roomSize = juce::jlimit(0.1f, 20.0f, seconds);
+
+    if (requestedRoomSize.exchange(roomSize) != roomSize)
+        notify();
+}
+
+//==============================================================================
+void ConvolutionReverb::process(juce::AudioBuffer<float>& buffer, int numSamples, float mix)
+{
+    // pick up a new impulse response once the worker has deleted the last
+    // one replaced. The worker must see the new engine before the old one
+    // is handed back, so it never deletes an engine it is about to run
+    if (pendingEngine.load() != nullptr && retiredEngine.load() == nullptr)
+    {
+        auto* replaced = engine;
+        engine = pendingEngine.exchange(nullptr);
+        activeEngine = engine;
+        retiredEngine = replaced;
+        notify();
+    }
+
+    // nothing has been fed in yet, so there is nothing to hear
+    if (!workerRequested.load(std::memory_order_relaxed))
+    {
+        if (mix <= 0.0f)
+            return;
+
+        workerRequested = true;
+        triggerAsyncUpdate();
+    }
+
+    if (engine == nullptr)
+        return;
+
+    auto& e = *engine;
+
+    // a silent input gives a silent reverb once the IR has passed through
+    const bool feedInput = mix > 0.0f;
+    const bool inputSilent = !feedInput || buffer.getMagnitude(0, numSamples) < 1.0e-6f;
+    e.silentSamples = inputSilent ? e.silentSamples + numSamples : 0;
+
+    if (e.silentSamples > e.irLength + 3 * tailPartitionSize
+        && e.tailBlocksProcessed.load(std::memory_order_acquire) == e.tailBlocksSubmitted.load(std::memory_order_relaxed))
+        return;
+
+    const int channels = juce::jmin(e.numChannels, buffer.getNumChannels());
+
+    for (int position = 0; position < numSamples;)
+    {
+        const int count = juce::jmin(numSamples - position, headPartitionSize - e.headFill);
+        const juce::int64 inputSample = e.headPartitions * headPartitionSize + e.headFill;
+        const int tailOffset = (int)((inputSample / tailPartitionSize) % numTailSlots) * tailPartitionSize
+                             + (int)(inputSample % tailPartitionSize);
+
+        for (int channel = 0; channel < channels; ++channel)
+        {
+            float* data = buffer.getWritePointer(channel, position);
+            float* headInput = e.headInput[channel] + e.headFill;
+
+            if (feedInput)
+                juce::FloatVectorOperations::copy(headInput, data, count);
+            else
+                juce::FloatVectorOperations::clear(headInput, count);
+
+            if (e.hasTail)
+                juce::FloatVectorOperations::copy(e.tailInput[channel] + tailOffset, headInput, count);
+
+            if (feedInput)
+            {
+                juce::FloatVectorOperations::multiply(data, 1.0f - mix, count);
+                juce::FloatVectorOperations::addWithMultiply(data, e.wetOutput[channel] + e.headFill, mix, count);
+            }
+        }
+
+        e.headFill += count;
+        position += count;
+
+        if (e.headFill == headPartitionSize)
+        {
+            runPartition(e);
+            e.headFill = 0;
+        }
+    }
+}
+
+/*
+ *  Runs a full head partition. Its wet output covers the same samples as
+ *  the partition's input and plays while the next one fills. Tail frame m
+ *  comes from tail block m - 2, which was complete when frame m - 1 started.
+ */
+void ConvolutionReverb::runPartition(Engine& e)
+{
+    const int channels = e.numChannels;
+    const juce::int64 firstSample = e.headPartitions * headPartitionSize;
+
+    for (int channel = 0; channel < channels; ++channel)
+        e.head[channel]->process(e.headInput[channel], e.wetOutput[channel]);
+
+    if (e.hasTail)
+    {
+        const juce::int64 frame = firstSample / tailPartitionSize;
+        const int frameOffset = (int)(firstSample % tailPartitionSize);
+
+        if (frameOffset == 0 && frame >= 2)
+        {
+            e.tailFrameReady = e.tailBlocksProcessed.load(std::memory_order_acquire) >= frame - 1;
+            if (!e.tailFrameReady)
+                ++lateTailFrames;
+        }
+
+        if (frame >= 2 && e.tailFrameReady)
+        {
+            const int slotOffset = (int)(frame % numTailSlots) * tailPartitionSize + frameOffset;
+            for (int channel = 0; channel < channels; ++channel)
+                juce::FloatVectorOperations::add(e.wetOutput[channel], e.tailOutput[channel] + slotOffset, headPartitionSize);
+        }
+
+        const juce::int64 inputEnd = firstSample + headPartitionSize;
+        if (inputEnd % tailPartitionSize == 0)
+        {
+            e.tailBlocksSubmitted.store(inputEnd / tailPartitionSize, std::memory_order_release);
+
+            if (synchronous.load())
+            {
+                while (tailBusy.exchange(true, std::memory_order_acquire))
+                    juce::Thread::yield();
+
+                processTail(e);
+                tailBusy.store(false, std::memory_order_release);
+            }
+            else
+            {
+                notify();
+            }
+        }
+    }
+
+    ++e.headPartitions;
+}
+
+/*
+ *  Runs every submitted tail block. A thread that has fallen so far behind
+ *  that the audio thread may be overwriting the input feeds silence
+ *  instead, keeping the delay line in step without reading torn input.
+ */
+void ConvolutionReverb::processTail(Engine& e)
+{
+    auto processed = e.tailBlocksProcessed.load(std::memory_order_relaxed);
+    const auto submitted = e.tailBlocksSubmitted.load(std::memory_order_acquire);
+
+    while (processed < submitted)
+    {
+        const bool behind = submitted - processed >= numTailSlots - 1;
+        const int inputOffset = (int)(processed % numTailSlots) * tailPartitionSize;
+        const int outputOffset = (int)((processed + 2) % numTailSlots) * tailPartitionSize;
+
+        for (int channel = 0; channel < e.numChannels; ++channel)
+        {
+            e.tail[channel]->process(behind ? nullptr : e.tailInput[channel] + inputOffset,
+                                     behind ? nullptr : e.tailOutput[channel] + outputOffset);
+        }
+
+        e.tailBlocksProcessed.store(++processed, std::memory_order_release);
+    }
+}
+
+//==============================================================================
+void ConvolutionReverb::run()
+{
+    float seenRoomSize = builtRoomSize;
+    juce::uint32 roomSizeChangedAt = 0;
+
+    while (!threadShouldExit())
+    {
+        delete retiredEngine.exchange(nullptr);
+
+        if (!synchronous.load())
+        {
+            auto* e = activeEngine.load();
+            if (e != nullptr && e->hasTail
+                && e->tailBlocksProcessed.load(std::memory_order_relaxed) < e->tailBlocksSubmitted.load(std::memory_order_acquire)
+                && !tailBusy.exchange(true, std::memory_order_acquire))
+            {
+                processTail(*e);
+                tailBusy.store(false, std::memory_order_release);
+            }
+        }
+
+        // a new file is built straight away, a room size once the knob has
+        // stopped moving for a moment
+        const auto now = juce::Time::getMillisecondCounter();
+        const float roomSize = requestedRoomSize.load();
+        if (roomSize != seenRoomSize)
+        {
+            seenRoomSize = roomSize;
+            roomSizeChangedAt = now;
+        }
+
+        const bool fileChanged = requestedFileGeneration.load() != builtFileGeneration;
+        const bool roomChanged = builtFile == juce::File() && roomSize != builtRoomSize
+                              && now - roomSizeChangedAt > (juce::uint32)roomSizeSettleMs;
+
+        if ((fileChanged || roomChanged) && pendingEngine.load() == nullptr)
+        {
+            {
+                const juce::ScopedLock sl (fileLock);
+                builtFile = requestedFile;
+                builtFileGeneration = requestedFileGeneration.load();
+            }
+            builtRoomSize = roomSize;
+
+            pendingEngine = buildEngine(builtRoomSize, builtFile).release();
+        }
+
+        // sleeps until there is a tail block, a replaced engine or a new
+        // impulse response. A room size that is still settling is looked at
+        // again once it has had time to
+        const bool roomSettling = builtFile == juce::File() && roomSize != builtRoomSize
+                               && pendingEngine.load() == nullptr;
+        wait(roomSettling ? roomSizeSettleMs : -1);
+    }
+}
+
+std::unique_ptr<ConvolutionReverb::Engine> ConvolutionReverb::buildEngine(float roomSize, const juce::File& file)
+{
+    juce::AudioBuffer<float> ir;
+    if (file == juce::File() || !readImpulseResponse(file, ir))
+        generateRoom(roomSize, ir);
+
+    // the loudest channel gets unit energy, so the wet level is about the dry level
+    double energy = 0.0;
+    for (int channel = 0; channel < ir.getNumChannels(); ++channel)
+    {
+        double channelEnergy = 0.0;
+        for (int sample = 0; sample < ir.getNumSamples(); ++sample)
+            channelEnergy += (double)ir.getSample(channel, sample) * ir.getSample(channel, sample);
+        energy = juce::jmax(energy, channelEnergy);
+    }
+    if (energy > 0.0)
+        ir.applyGain((float)(1.0 / std::sqrt(energy)));
+
+    auto e = std::make_unique<Engine>();
+    e->numChannels = numChannels;
+    e->irLength = ir.getNumSamples();
+    tailLengthSeconds = e->irLength / sampleRate;
+    e->hasTail = e->irLength > 2 * tailPartitionSize;
+
+    const int headLength = juce::jmin(e->irLength, 2 * tailPartitionSize);
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        const float* h = ir.getReadPointer(juce::jmin(channel, ir.getNumChannels() - 1));
+        e->head[channel] = std::make_unique<PartitionedConvolver>(h, headLength, headPartitionSize);
+
+        if (e->hasTail)
+        {
+            e->tail[channel] = std::make_unique<PartitionedConvolver>(h + 2 * tailPartitionSize, e->irLength - 2 * tailPartitionSize, tailPartitionSize);
+            e->tailInput[channel].allocate(numTailSlots * tailPartitionSize, true);
+            e->tailOutput[channel].allocate(numTailSlots * tailPartitionSize, true);
+        }
+    }
+
+    return e;
+}
+
+/* Reads up to 20 seconds of a file, resampled to the reverb's rate */
+bool ConvolutionReverb::readImpulseResponse(const juce::File& file, juce::AudioBuffer<float>& ir)
+{
+    juce::AudioFormatManager formats;
+    formats.registerBasicFormats();
+
+    std::unique_ptr<juce::AudioFormatReader> reader (formats.createReaderFor(file));
+    if (reader == nullptr || reader->lengthInSamples <= 0 || reader->sampleRate <= 0.0)
+        return false;
+
+    const int fileLength = (int)juce::jmin(reader->lengthInSamples, (juce::int64)(20.0 * reader->sampleRate));
+    const int fileChannels = juce::jlimit(1, maxChannels, (int)reader->numChannels);
+
+    juce::AudioBuffer<float> source (fileChannels, fileLength);
+    if (!reader->read(&source, 0, fileLength, 0, true, fileChannels > 1))
+        return false;
+
+    const double ratio = reader->sampleRate / sampleRate;
+    const int length = juce::jmax(1, (int)(fileLength / ratio));
+    ir.setSize(fileChannels, length);
+
+    for (int channel = 0; channel < fileChannels; ++channel)
+    {
+        juce::LagrangeInterpolator interpolator;
+        interpolator.process(ratio, source.getReadPointer(channel), ir.getWritePointer(channel), length, fileLength, 0);
+    }
+
+    return true;
+}
+
+/*
+ *  Exponentially decaying noise that falls by 60 dB over roomSize seconds
+ *  and gets darker as it decays. Each channel has its own fixed seed, so the
+ *  channels are decorrelated and every build of a size is the same.
+ */
+void ConvolutionReverb::generateRoom(float roomSize, juce::AudioBuffer<float>& ir)
+{
+    const int length = juce::jmax(1, (int)(roomSize * sampleRate));
+    ir.setSize(numChannels, length);
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        juce::Random random (0x5eed + channel);
+        float* h = ir.getWritePointer(channel);
+        float lowpass = 0.0f;
+
+        for (int sample = 0; sample < length; ++sample)
+        {
+            const float progress = (float)sample / (float)length;
+            const float decay = std::exp(-6.9078f * progress);
+            const float damping = 0.1f + 0.8f * progress;
+
+            lowpass += (1.0f - damping) * (random.nextFloat() * 2.0f - 1.0f - lowpass);
+            h[sample] = lowpass * decay;
+        }
+    }
+}
@@ -0,0 +1,126 @@
+/*
+  ==============================================================================
+
+    ConvolutionReverb.h
+    Created: 19 Oct 2026
+    Author:  woz
+    Notes: Master bus reverb that convolves with an impulse response using
+           uniformly partitioned overlap-save FFT convolution in two parts:
+
+               head   the first 2 * tailPartitionSize samples of the IR in
+                      partitions of headPartitionSize, on the audio thread
+               tail   the rest in partitions of tailPartitionSize, on a
+                      worker thread
+
+           The wet signal is delayed by one head partition (64 samples),
+           which works as a short pre-delay. The dry signal is not delayed,
+           so the plugin reports no extra latency. The worker gets each tail
+           block as soon as it is full and has a whole tail partition before
+           the audio thread needs the result. A frame that isn't ready in
+           time is left out of the tail and counted, it is never waited for.
+           Renders without a deadline process the tail inline instead, so
+           bounces stay deterministic.
+
+           Impulse responses, generated or read from a file, are cut into
+           partitions and transformed on the worker. Each one gets an Engine
+           that is handed to the audio thread through an atomic pointer, and
+           the worker deletes the engine it replaced. Once its input has been
+           silent for longer than the IR, the reverb skips its processing.
+
+           The worker sleeps on its thread event and is woken for each tail
+           block, replaced engine or new impulse response. It isn't started
+           until the mix is first above 0, until then the reverb does nothing.
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+class ConvolutionReverb : private juce::Thread,
+                          private juce::AsyncUpdater
+{
+public:
+    static constexpr int headPartitionSize = 64;
+    static constexpr int tailPartitionSize = 1024;
+    static constexpr int maxChannels = 2;
+
+    ConvolutionReverb();
+    ~ConvolutionReverb() override;
+
+    /* Builds the impulse response for the rate, and starts the worker if
+       mix is above 0. Otherwise the worker is started from the message
+       thread once process() is given a mix above 0. Not realtime safe */
+    void prepare(double sampleRate, int numChannels, float mix);
+
+    /* Stops the worker and frees the impulse response */
+    void release();
+
+    /* Silences the reverb, clearing the input it still remembers. Doesn't
+       allocate, call it from the audio thread or while it isn't processing */
+    void reset();
+
+    /* Reads an impulse response from an audio file on the worker thread. An
+       empty file goes back to the generated room. Not for the audio thread */
+    void loadImpulseResponse(const juce::File& file);
+
+    /* Decay time in seconds of the generated room, which the worker rebuilds
+       when it changes. Safe from the audio thread */
+    void setRoomSize(float seconds);
+
+    /* Processes the tail on the calling thread rather than the worker */
+    void setSynchronous(bool shouldProcessInline) { synchronous = shouldProcessInline; }
+
+    /* Mixes the reverb of the first numSamples of buffer into it, mix from 0 to 1 */
+    void process(juce::AudioBuffer<float>& buffer, int numSamples, float mix);
+
+    /* How long the newest impulse response rings for */
+    double getTailLengthSeconds() const { return tailLengthSeconds.load(); }
+
+    /* Tail frames left out because the worker was late, since prepare */
+    int getNumLateTailFrames() const { return lateTailFrames.load(); }
+
+private:
+    class PartitionedConvolver;
+    struct Engine;
+
+    static constexpr int numTailSlots = 4;
+    static constexpr int roomSizeSettleMs = 100;
+
+    double sampleRate = 0.0;
+    int numChannels = 0;
+
+    Engine* engine = nullptr;                       // the audio thread's
+    std::atomic<Engine*> activeEngine { nullptr };  // the same, for the worker
+    std::atomic<Engine*> pendingEngine { nullptr }; // built, waiting for the audio thread
+    std::atomic<Engine*> retiredEngine { nullptr }; // replaced, waiting for the worker to delete it
+
+    std::atomic<float> requestedRoomSize { 2.5f };
+    std::atomic<int> requestedFileGeneration { 0 };
+    juce::CriticalSection fileLock;
+    juce::File requestedFile;
+
+    // what the newest engine was built from, only touched by the worker
+    // and by prepare while the worker is stopped
+    float builtRoomSize = 0.0f;
+    int builtFileGeneration = 0;
+    juce::File builtFile;
+
+    std::atomic<bool> workerRequested { false };
+    std::atomic<double> tailLengthSeconds { 0.0 };
+    std::atomic<bool> synchronous { false };
+    std::atomic<bool> tailBusy { false };
+    std::atomic<int> lateTailFrames { 0 };
+
+    std::unique_ptr<Engine> buildEngine(float roomSize, const juce::File& file);
+    bool readImpulseResponse(const juce::File& file, juce::AudioBuffer<float>& ir);
+    void generateRoom(float roomSize, juce::AudioBuffer<float>& ir);
+    void runPartition(Engine&);
+    void processTail(Engine&);
+    void deleteEngines();
+    void stopWorker();
+    void run() override;
+    void handleAsyncUpdate() override;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ConvolutionReverb)
+};
@@ -0,0 +1,68 @@
+/*
+  ==============================================================================
+
+    CpuGovernor.cpp
+    Created: 19 Oct 2026
+    Author:  woz
+
+  ==============================================================================
+*/
+
+#include "CpuGovernor.h"
+
+/*
+ *  The cheapest things to lose come first: modulation resolution and the
+ *  quiet end of release tails, then whole voices.
+ */
+CpuGovernor::Degradation CpuGovernor::getDegradation(int level) noexcept
+{
+    switch (level)
+    {
+    case 1:  return { 2, -70.0f, 1.0f };
+    case 2:  return { 4, -50.0f, 0.75f };
+    case 3:  return { 4, -40.0f, 0.5f };
+    default: return { 1, -200.0f, 1.0f };
+    }
+}
+
+bool CpuGovernor::update(float load, int numSamples, double sampleRate) noexcept
+{
+    if (sampleRate <= 0.0 || numSamples <= 0)
+        return false;
+
+    const double blockSeconds = numSamples / sampleRate;
+    const float alpha = (float)(1.0 - std::exp(-blockSeconds / loadTimeConstant));
+    smoothedLoad += alpha * (load - smoothedLoad);
+    secondsSinceChange += blockSeconds;
+
+    // an overrun steps down straight away, a high average once the last step has settled
+    const bool overloaded = load > 1.0f || (smoothedLoad > raiseLoad && secondsSinceChange >= settleSeconds);
+
+    if (overloaded && level < numLevels - 1)
+    {
+        ++level;
+        secondsSinceChange = 0.0;
+        secondsBelowLower = 0.0;
+        return true;
+    }
+
+    secondsBelowLower = smoothedLoad < lowerLoad ? secondsBelowLower + blockSeconds : 0.0;
+
+    if (level > 0 && secondsBelowLower >= holdSeconds)
+    {
+        --level;
+        secondsSinceChange = 0.0;
+        secondsBelowLower = 0.0;
+        return true;
+    }
+
+    return false;
+}
+
+void CpuGovernor::reset() noexcept
+{
+    level = 0;
+    smoothedLoad = 0.0f;
+    secondsSinceChange = 0.0;
+    secondsBelowLower = 0.0;
+}
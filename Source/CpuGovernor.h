@@ -0,0 +1,57 @@
+/*
+  ==============================================================================
+
+    CpuGovernor.h
+    Created: 19 Oct 2026
+    Author:  woz
+    Notes: Watches how much of its deadline each processBlock used and steps
+           the processor down a ladder of cheaper settings when it gets close
+           to running out, then back up once the load has stayed low for a
+           while. Stepping down is quick and stepping up is slow, with a gap
+           between the two thresholds, so it doesn't flap on a busy passage.
+
+           Audio thread only, nothing here allocates or locks.
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+class CpuGovernor
+{
+public:
+    static constexpr int numLevels = 4; // level 0 is full quality
+
+    /* What a level gives up, the processor applies it to both renderers */
+    struct Degradation
+    {
+        int controlRateScale;       // multiplies the voice control interval
+        float silenceThresholdDb;   // released voices below this are freed, never lower than the configured one
+        float polyphonyScale;       // fraction of the voices that may play at once
+    };
+
+    static Degradation getDegradation(int level) noexcept;
+
+    /* Feeds the load of the block that just finished (time taken over
+       numSamples / sampleRate). Returns true when the level has changed */
+    bool update(float load, int numSamples, double sampleRate) noexcept;
+
+    int getLevel() const noexcept { return level; }
+    float getSmoothedLoad() const noexcept { return smoothedLoad; }
+
+    /* Back to full quality, for when the governor is switched off */
+    void reset() noexcept;
+
+private:
+    static constexpr float raiseLoad = 0.85f;       // smoothed load that steps down a level
+    static constexpr float lowerLoad = 0.5f;        // smoothed load that has to hold before stepping up
+    static constexpr double loadTimeConstant = 0.05;
+    static constexpr double settleSeconds = 0.1;    // between two steps down, so the last one can take effect
+    static constexpr double holdSeconds = 1.0;      // of low load before each step up
+
+    int level = 0;
+    float smoothedLoad = 0.0f;
+    double secondsSinceChange = 0.0;
+    double secondsBelowLower = 0.0;
+};
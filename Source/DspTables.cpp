@@ -0,0 +1,17 @@
+/*
+  ==============================================================================
+
+    DspTables.cpp
+    Created: 19 Oct 2026
+    Author:  woz
+
+  ==============================================================================
+*/
+
+#include "DspTables.h"
+
+DspTables::DspTables()
+    : saturationFloat ([] (float x) { return std::tanh (x); }, -5.0f, 5.0f, saturationSize),
+      saturationDouble ([] (double x) { return std::tanh (x); }, -5.0, 5.0, saturationSize)
+{
+}
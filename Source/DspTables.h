@@ -0,0 +1,41 @@
+/*
+  ==============================================================================
+
+    DspTables.h
+    Created: 19 Oct 2026
+    Author:  woz
+    Notes: Read-only lookup tables shared by every voice of every plugin
+           instance in the process. Hold a juce::SharedResourcePointer<DspTables>
+           for as long as the tables are used: the first pointer builds them,
+           the last one to go frees them. Pointers are created with the voices
+           on the message thread, so the audio thread only ever reads.
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+class DspTables
+{
+public:
+    DspTables();
+
+    /* tanh over [-5, 5], the ladder filter's saturation */
+    template <typename SampleType>
+    const juce::dsp::LookupTableTransform<SampleType>& getSaturation() const noexcept;
+
+private:
+    static constexpr int saturationSize = 128;
+
+    juce::dsp::LookupTableTransform<float> saturationFloat;
+    juce::dsp::LookupTableTransform<double> saturationDouble;
+
+    JUCE_DECLARE_NON_COPYABLE (DspTables)
+};
+
+template <>
+inline const juce::dsp::LookupTableTransform<float>& DspTables::getSaturation<float>() const noexcept     { return saturationFloat; }
+
+template <>
+inline const juce::dsp::LookupTableTransform<double>& DspTables::getSaturation<double>() const noexcept   { return saturationDouble; }
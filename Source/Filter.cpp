@@ -130,6 +130,33 @@ SampleType Filter<SampleType>::processSample (SampleType inputValue, size_t chan
     return a * A[0] + b * A[1] + c * A[2] + d * A[3] + e * A[4];
 }
 
+//==============================================================================
+template <typename SampleType>
+typename Filter<SampleType>::Coefficients Filter<SampleType>::getFrozenCoefficients() noexcept
+{
+    // the smoothers may have been reset without a call to updateSmoothers()
+    cutoffTransformValue = cutoffTransformSmoother.getCurrentValue();
+    scaledResonanceValue = scaledResonanceSmoother.getCurrentValue();
+
+    return makeCoefficients();
+}
+
+//==============================================================================
+template <typename SampleType>
+typename Filter<SampleType>::Coefficients Filter<SampleType>::makeCoefficients() const noexcept
+{
+    const auto g = cutoffTransformValue * SampleType (-1) + SampleType (1);
+    return { cutoffTransformValue, g * SampleType (0.76923076923), g * SampleType (0.23076923076), scaledResonanceValue };
+}
+
+//==============================================================================
+template <typename SampleType>
+SampleType Filter<SampleType>::processSampleFrozen (SampleType inputValue, std::array<SampleType, numStates>& s, const Coefficients& k) noexcept
+{
+    ladderStep (inputValue, s, k);
+    return s[0] * A[0] + s[1] * A[1] + s[2] * A[2] + s[3] * A[3] + s[4] * A[4];
+}
+
 //==============================================================================
 template <typename SampleType>
 void Filter<SampleType>::updateSmoothers() noexcept
@@ -143,15 +170,25 @@ template <typename SampleType>
 void Filter<SampleType>::setSampleRate (SampleType newValue) noexcept
 {
     jassert (newValue > SampleType (0));
+    sampleRate = newValue;
     cutoffFreqScaler = SampleType (-2.0 * juce::MathConstants<double>::pi) / newValue;
 
-    static constexpr SampleType smootherRampTimeSec = SampleType (0.05);
-    cutoffTransformSmoother.reset (newValue, smootherRampTimeSec);
-    scaledResonanceSmoother.reset (newValue, smootherRampTimeSec);
+    cutoffTransformSmoother.reset (newValue, smoothingTimeSec);
+    scaledResonanceSmoother.reset (newValue, smoothingTimeSec);
 
     updateCutoffFreq();
 }
 
+//==============================================================================
+template <typename SampleType>
+void Filter<SampleType>::setSmoothingTime (SampleType seconds) noexcept
+{
+    smoothingTimeSec = seconds;
+
+    cutoffTransformSmoother.reset (sampleRate, smoothingTimeSec);
+    scaledResonanceSmoother.reset (sampleRate, smoothingTimeSec);
+}
+
 //==============================================================================
 template class Filter<float>;
 template class Filter<double>;
@@ -13,6 +13,7 @@
 
 #pragma once
 #include <JuceHeader.h>
+#include "DspTables.h"
 
 enum class FilterMode
 {
@@ -68,6 +69,10 @@ public:
     */
     void setDrive (SampleType newDrive) noexcept;
 
+    /** Sets how long cutoff and resonance changes ramp for. The filter state is kept,
+        a ramp in progress jumps to its target. */
+    void setSmoothingTime (SampleType seconds) noexcept;
+
     //==============================================================================
     template <typename ProcessContext>
     void process (const ProcessContext& context) noexcept
@@ -87,6 +92,13 @@ public:
             return;
         }
 
+        // nothing is ramping, so the coefficients are constant for the whole block
+        if (! isSmoothing())
+        {
+            processFrozen (inputBlock, outputBlock, numChannels, numSamples);
+            return;
+        }
+
         for (size_t n = 0; n < numSamples; ++n)
         {
             updateSmoothers();
@@ -100,7 +112,104 @@ public:
     SampleType processSample (SampleType inputValue, size_t channelToUse) noexcept;
     void updateSmoothers() noexcept;
 
+    /** Returns true while the cutoff or resonance is still ramping to a new value. */
+    bool isSmoothing() const noexcept            { return cutoffTransformSmoother.isSmoothing() || scaledResonanceSmoother.isSmoothing(); }
+
+    /** Returns the current filter mode. */
+    Mode getMode() const noexcept                { return mode; }
+
+    //==============================================================================
+    /** Coefficients of the ladder that only depend on the smoothed cutoff and resonance. */
+    struct Coefficients
+    {
+        SampleType a1, b0, b1, resonance;
+    };
+
+    /** Returns the coefficients for the current smoother values without advancing them. */
+    Coefficients getFrozenCoefficients() noexcept;
+
+    /** Advances the smoothers by one sample and returns the new coefficients. */
+    Coefficients getNextCoefficients() noexcept   { updateSmoothers(); return makeCoefficients(); }
+
+    /** Processes one sample on the first channel with the output mix of a fixed mode.
+        This is used by the fused voice kernels, which feed every channel the same
+        mono signal. Call mirrorFirstChannelState() once the block is done so the
+        other channels stay in step.
+    */
+    template <Mode M>
+    SampleType processFirstChannelSample (SampleType inputValue, const Coefficients& k) noexcept
+    {
+        auto& s = state[0];
+        ladderStep (inputValue, s, k);
+        return mixForMode<M> (s);
+    }
+
+    /** Copies the state of the first channel to all the other channels. */
+    void mirrorFirstChannelState() noexcept
+    {
+        for (size_t ch = 1; ch < state.size(); ++ch)
+            state[ch] = state[0];
+    }
+
 private:
+    //==============================================================================
+    static constexpr size_t numStates = 5;
+
+    Coefficients makeCoefficients() const noexcept;
+    SampleType processSampleFrozen (SampleType inputValue, std::array<SampleType, numStates>& s, const Coefficients& k) noexcept;
+
+    void ladderStep (SampleType inputValue, std::array<SampleType, numStates>& s, const Coefficients& k) noexcept
+    {
+        const auto dx = gain * saturationLUT (drive * inputValue);
+        const auto a  = dx + k.resonance * SampleType (-4) * (gain2 * saturationLUT (drive2 * s[4]) - dx * comp);
+
+        const auto b = k.b1 * s[0] + k.a1 * s[1] + k.b0 * a;
+        const auto c = k.b1 * s[1] + k.a1 * s[2] + k.b0 * b;
+        const auto d = k.b1 * s[2] + k.a1 * s[3] + k.b0 * c;
+        const auto e = k.b1 * s[3] + k.a1 * s[4] + k.b0 * d;
+
+        s[0] = a;
+        s[1] = b;
+        s[2] = c;
+        s[3] = d;
+        s[4] = e;
+    }
+
+    /** Same output mix as setMode() builds in A, with the zero terms left out. */
+    template <Mode M>
+    static SampleType mixForMode (const std::array<SampleType, numStates>& s) noexcept
+    {
+        constexpr auto g = SampleType (1.2);
+
+        switch (M)
+        {
+            case Mode::LPF12:   return s[2] * g;
+            case Mode::HPF12:   return s[0] * g + s[1] * (SampleType (-2) * g) + s[2] * g;
+            case Mode::BPF12:   return s[2] * (SampleType (-1) * g) + s[3] * g;
+            case Mode::LPF24:   return s[4] * g;
+            case Mode::HPF24:   return s[0] * g + s[1] * (SampleType (-4) * g) + s[2] * (SampleType (6) * g) + s[3] * (SampleType (-4) * g) + s[4] * g;
+            case Mode::BPF24:   return s[2] * g + s[3] * (SampleType (-2) * g) + s[4] * g;
+        }
+
+        return SampleType (0);
+    }
+
+    template <typename InputBlock, typename OutputBlock>
+    void processFrozen (const InputBlock& inputBlock, OutputBlock& outputBlock, size_t numChannels, size_t numSamples) noexcept
+    {
+        const auto k = getFrozenCoefficients();
+
+        for (size_t ch = 0; ch < numChannels; ++ch)
+        {
+            auto& s = state[ch];
+            auto* input = inputBlock.getChannelPointer (ch);
+            auto* output = outputBlock.getChannelPointer (ch);
+
+            for (size_t n = 0; n < numSamples; ++n)
+                output[n] = processSampleFrozen (input[n], s, k);
+        }
+    }
+
     //==============================================================================
     void setSampleRate (SampleType newValue) noexcept;
     void setNumChannels (size_t newValue)   { state.resize (newValue); }
@@ -110,20 +219,22 @@ private:
     //==============================================================================
     SampleType drive, drive2, gain, gain2, comp;
 
-    static constexpr size_t numStates = 5;
     std::vector<std::array<SampleType, numStates>> state;
     std::array<SampleType, numStates> A;
 
     juce::SmoothedValue<SampleType> cutoffTransformSmoother, scaledResonanceSmoother;
     SampleType cutoffTransformValue, scaledResonanceValue;
 
-    juce::dsp::LookupTableTransform<SampleType> saturationLUT { [] (SampleType x) { return std::tanh (x); },
-                                                     SampleType (-5), SampleType (5), 128 };
+    // shared by every filter in the process rather than built per voice
+    juce::SharedResourcePointer<DspTables> tables;
+    const juce::dsp::LookupTableTransform<SampleType>& saturationLUT { tables->template getSaturation<SampleType>() };
 
     SampleType cutoffFreqHz { SampleType (200) };
     SampleType resonance;
 
+    SampleType sampleRate;
     SampleType cutoffFreqScaler;
+    SampleType smoothingTimeSec { SampleType (0.05) };
 
     Mode mode;
     bool enabled = true;
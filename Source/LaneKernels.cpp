@@ -0,0 +1,166 @@
+/*
+  ==============================================================================
+
+    LaneKernels.cpp
+    Created: 19 Oct 2026
+    Author:  woz
+
+  ==============================================================================
+*/
+
+#include "LaneKernels.h"
+
+#if JUCE_INTEL
+ #if JUCE_MSVC
+  #include <intrin.h>
+ #else
+  #include <cpuid.h>
+ #endif
+#endif
+
+namespace LaneKernels
+{
+namespace scalar
+{
+    /* One lane at a time, the fallback on every machine */
+    struct Vec
+    {
+        using Float = float;
+        using Int = uint32_t;
+        using Mask = bool;
+
+        static constexpr int width = 1;
+        static constexpr SimdLevel level = SimdLevel::Scalar;
+
+        static Float load(const float* p)                  { return *p; }
+        static void store(float* p, Float x)               { *p = x; }
+        static Float set(float x)                          { return x; }
+        static Float add(Float a, Float b)                 { return a + b; }
+        static Float sub(Float a, Float b)                 { return a - b; }
+        static Float mul(Float a, Float b)                 { return a * b; }
+        static Float div(Float a, Float b)                 { return a / b; }
+        static Float min(Float a, Float b)                 { return std::min(a, b); }
+        static Float max(Float a, Float b)                 { return std::max(a, b); }
+        static Float floor(Float x)                        { return std::floor(x); }
+        static Mask less(Float a, Float b)                 { return a < b; }
+        static Mask greater(Float a, Float b)              { return a > b; }
+        static Float select(Mask m, Float a, Float b)      { return m ? a : b; }
+        static Float sum(Float x)                          { return x; }
+
+        static Int loadInt(const uint32_t* p)              { return *p; }
+        static void storeInt(uint32_t* p, Int x)           { *p = x; }
+        static Float top24BitsToFloat(Int x)               { return (float)(x >> 8); }
+
+        static Int xorshift(Int x)
+        {
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+            return x;
+        }
+    };
+}
+}
+
+#define SYMPLE_LANE_NAMESPACE scalar
+#define SYMPLE_LANE_TARGET
+#include "LaneKernelsImpl.h"
+
+namespace
+{
+   #if JUCE_INTEL
+    /*
+     *  The register state the os saves on a context switch (XCR0). A cpu can
+     *  report AVX while the os still only saves the SSE registers.
+     */
+    juce::uint64 getEnabledRegisterState()
+    {
+       #if JUCE_MSVC
+        int info[4];
+        __cpuid(info, 1);
+        if ((info[2] & (1 << 27)) == 0) // OSXSAVE
+            return 0;
+
+        return _xgetbv(0);
+       #else
+        unsigned int eax, ebx, ecx, edx;
+        if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx) || (ecx & (1u << 27)) == 0)
+            return 0;
+
+        __asm__ volatile ("xgetbv" : "=a" (eax), "=d" (edx) : "c" (0));
+        return ((juce::uint64)edx << 32) | eax;
+       #endif
+    }
+
+    SimdLevel detectCpuLevel()
+    {
+        const auto state = getEnabledRegisterState();
+        const bool savesYmm = (state & 0x06) == 0x06;     // sse and avx state
+        const bool savesZmm = (state & 0xe6) == 0xe6;     // plus opmask and the upper zmm registers
+
+        if (savesZmm && juce::SystemStats::hasAVX512F() && LaneKernels::getAVX512Table() != nullptr)
+            return SimdLevel::AVX512;
+
+        if (savesYmm && juce::SystemStats::hasAVX2() && juce::SystemStats::hasFMA3() && LaneKernels::getAVX2Table() != nullptr)
+            return SimdLevel::AVX2;
+
+        if (juce::SystemStats::hasSSE2() && LaneKernels::getSSE2Table() != nullptr)
+            return SimdLevel::SSE2;
+
+        return SimdLevel::Scalar;
+    }
+   #else
+    SimdLevel detectCpuLevel()
+    {
+        return SimdLevel::Scalar;
+    }
+   #endif
+}
+
+SimdLevel LaneKernels::getCpuLevel()
+{
+    static const SimdLevel level = detectCpuLevel();
+    return level;
+}
+
+const LaneKernels::Table& LaneKernels::getTable(SimdLevel maximumLevel)
+{
+    const auto level = (SimdLevel)juce::jmin((int)maximumLevel, (int)getCpuLevel());
+
+    switch (level)
+    {
+    case SimdLevel::AVX512:  return *getAVX512Table();
+    case SimdLevel::AVX2:    return *getAVX2Table();
+    case SimdLevel::SSE2:    return *getSSE2Table();
+    case SimdLevel::Scalar:  break;
+    }
+
+    return scalar::table;
+}
+
+const char* LaneKernels::getLevelName(SimdLevel level)
+{
+    switch (level)
+    {
+    case SimdLevel::Scalar:  return "scalar";
+    case SimdLevel::SSE2:    return "sse2";
+    case SimdLevel::AVX2:    return "avx2";
+    case SimdLevel::AVX512:  return "avx512";
+    }
+
+    return "";
+}
+
+bool LaneKernels::parseLevel(const juce::String& name, SimdLevel& level)
+{
+    for (auto candidate : { SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::AVX512 })
+    {
+        if (name.equalsIgnoreCase(getLevelName(candidate)))
+        {
+            level = candidate;
+            return true;
+        }
+    }
+
+    return false;
+}
@@ -0,0 +1,90 @@
+/*
+  ==============================================================================
+
+    LaneKernels.h
+    Created: 19 Oct 2026
+    Author:  woz
+    Notes: The VoiceEngine stage loops (oscillators, noise, filters, envelope
+           gain and the lane mixdown) compiled once per instruction set.
+           The kernel bodies live in LaneKernelsImpl.h and are built by
+           LaneKernels.cpp (scalar), LaneKernelsSSE2.cpp, LaneKernelsAVX2.cpp
+           and LaneKernelsAVX512.cpp. VoiceEngine picks a table in prepare,
+           so one binary uses the widest vectors the machine has.
+
+           Every variant runs the same arithmetic in the same order across a
+           lane, so they only differ by fused multiply-adds and the order of
+           the mixdown sum.
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "Osc.h"
+
+enum class SimdLevel
+{
+    Scalar,
+    SSE2,
+    AVX2,   // with FMA
+    AVX512  // AVX-512F
+};
+
+namespace LaneKernels
+{
+    constexpr int numLanes = 16;
+    constexpr int numOscillatorModes = 5; // noise renders silence, it has its own kernel
+
+    /* The largest sample difference any level may have from the scalar kernels.
+       The fused multiply-adds stay under 1e-6 per lane, a broken kernel is
+       off by whole percents. */
+    constexpr float maxDifferenceFromScalar = 1.0e-4f;
+
+    using LaneBuffer = float (*)[numLanes];      // [sample][lane]
+    using ConstLaneBuffer = const float (*)[numLanes];
+
+    /* One block of ladder filter lanes, laid out like VoiceEngine::FilterLanes */
+    struct FilterArgs
+    {
+        float* s[5];
+        const float* a1;
+        const float* b0;
+        const float* b1;
+        float mix[5];
+        float comp;
+        float scaledResonance;
+        float drive, driveGain, drive2, driveGain2;
+    };
+
+    using OscillatorKernel = void (*)(float* phase, const float* increment, float* lastOutput, int numSamples, float gain, LaneBuffer out);
+    using NoiseKernel = void (*)(uint32_t* state, int numSamples, float gain, LaneBuffer io);
+    using FilterKernel = void (*)(const FilterArgs&, int numSamples, LaneBuffer io);
+    using EnvelopeGainKernel = void (*)(LaneBuffer path1, LaneBuffer path2, ConstLaneBuffer envelope, int numSamples);
+    using MixKernel = void (*)(ConstLaneBuffer path1, ConstLaneBuffer path2, int numPlayingLanes, int numSamples, float* output);
+
+    struct Table
+    {
+        SimdLevel level;
+        OscillatorKernel oscillator[numOscillatorModes]; // indexed by OscillatorMode
+        NoiseKernel noise;
+        FilterKernel filter;
+        EnvelopeGainKernel applyEnvelope;
+        MixKernel mix;
+    };
+
+    /* The widest level both this build and the running cpu and os support */
+    SimdLevel getCpuLevel();
+
+    /* The kernels for the widest supported level that is not above maximumLevel */
+    const Table& getTable(SimdLevel maximumLevel = SimdLevel::AVX512);
+
+    const char* getLevelName(SimdLevel);
+
+    /* Reads "scalar", "sse2", "avx2" or "avx512", returns false for anything else */
+    bool parseLevel(const juce::String& name, SimdLevel& level);
+
+    /* Defined by the variant files, nullptr when built for another architecture */
+    const Table* getSSE2Table();
+    const Table* getAVX2Table();
+    const Table* getAVX512Table();
+}
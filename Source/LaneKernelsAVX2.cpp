@@ -0,0 +1,86 @@
+/*
+  ==============================================================================
+
+    LaneKernelsAVX2.cpp
+    Created: 19 Oct 2026
+    Author:  woz
+
+  ==============================================================================
+*/
+
+#include "LaneKernels.h"
+
+#if JUCE_INTEL
+
+#include <immintrin.h>
+
+#if JUCE_MSVC
+ #define SYMPLE_LANE_TARGET
+#else
+ #define SYMPLE_LANE_TARGET __attribute__ ((target ("avx2,fma")))
+#endif
+
+namespace LaneKernels
+{
+namespace avx2
+{
+    struct Vec
+    {
+        using Float = __m256;
+        using Int = __m256i;
+        using Mask = __m256;
+
+        static constexpr int width = 8;
+        static constexpr SimdLevel level = SimdLevel::AVX2;
+
+        SYMPLE_LANE_TARGET static Float load(const float* p)               { return _mm256_loadu_ps(p); }
+        SYMPLE_LANE_TARGET static void store(float* p, Float x)            { _mm256_storeu_ps(p, x); }
+        SYMPLE_LANE_TARGET static Float set(float x)                       { return _mm256_set1_ps(x); }
+        SYMPLE_LANE_TARGET static Float add(Float a, Float b)              { return _mm256_add_ps(a, b); }
+        SYMPLE_LANE_TARGET static Float sub(Float a, Float b)              { return _mm256_sub_ps(a, b); }
+        SYMPLE_LANE_TARGET static Float mul(Float a, Float b)              { return _mm256_mul_ps(a, b); }
+        SYMPLE_LANE_TARGET static Float div(Float a, Float b)              { return _mm256_div_ps(a, b); }
+        SYMPLE_LANE_TARGET static Float min(Float a, Float b)              { return _mm256_min_ps(b, a); }
+        SYMPLE_LANE_TARGET static Float max(Float a, Float b)              { return _mm256_max_ps(b, a); }
+        SYMPLE_LANE_TARGET static Float floor(Float x)                     { return _mm256_floor_ps(x); }
+        SYMPLE_LANE_TARGET static Mask less(Float a, Float b)              { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+        SYMPLE_LANE_TARGET static Mask greater(Float a, Float b)           { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+        SYMPLE_LANE_TARGET static Float select(Mask m, Float a, Float b)   { return _mm256_blendv_ps(b, a, m); }
+
+        SYMPLE_LANE_TARGET static float sum(Float x)
+        {
+            const __m128 halves = _mm_add_ps(_mm256_castps256_ps128(x), _mm256_extractf128_ps(x, 1));
+            const __m128 pairs = _mm_add_ps(halves, _mm_movehl_ps(halves, halves));
+            return _mm_cvtss_f32(_mm_add_ss(pairs, _mm_shuffle_ps(pairs, pairs, 1)));
+        }
+
+        SYMPLE_LANE_TARGET static Int loadInt(const uint32_t* p)           { return _mm256_loadu_si256(reinterpret_cast<const __m256i*> (p)); }
+        SYMPLE_LANE_TARGET static void storeInt(uint32_t* p, Int x)        { _mm256_storeu_si256(reinterpret_cast<__m256i*> (p), x); }
+        SYMPLE_LANE_TARGET static Float top24BitsToFloat(Int x)            { return _mm256_cvtepi32_ps(_mm256_srli_epi32(x, 8)); }
+
+        SYMPLE_LANE_TARGET static Int xorshift(Int x)
+        {
+            x = _mm256_xor_si256(x, _mm256_slli_epi32(x, 13));
+            x = _mm256_xor_si256(x, _mm256_srli_epi32(x, 17));
+            return _mm256_xor_si256(x, _mm256_slli_epi32(x, 5));
+        }
+    };
+}
+}
+
+#define SYMPLE_LANE_NAMESPACE avx2
+#include "LaneKernelsImpl.h"
+
+const LaneKernels::Table* LaneKernels::getAVX2Table()
+{
+    return &avx2::table;
+}
+
+#else
+
+const LaneKernels::Table* LaneKernels::getAVX2Table()
+{
+    return nullptr;
+}
+
+#endif
@@ -0,0 +1,85 @@
+/*
+  ==============================================================================
+
+    LaneKernelsAVX512.cpp
+    Created: 19 Oct 2026
+    Author:  woz
+    Notes: Only AVX-512F instructions, a lane block is one register.
+
+  ==============================================================================
+*/
+
+#include "LaneKernels.h"
+
+#if JUCE_INTEL
+
+#include <immintrin.h>
+
+#if JUCE_MSVC
+ #define SYMPLE_LANE_TARGET
+#else
+ #define SYMPLE_LANE_TARGET __attribute__ ((target ("avx512f")))
+#endif
+
+namespace LaneKernels
+{
+namespace avx512
+{
+    struct Vec
+    {
+        using Float = __m512;
+        using Int = __m512i;
+        using Mask = __mmask16;
+
+        static constexpr int width = 16;
+        static constexpr SimdLevel level = SimdLevel::AVX512;
+
+        SYMPLE_LANE_TARGET static Float load(const float* p)               { return _mm512_loadu_ps(p); }
+        SYMPLE_LANE_TARGET static void store(float* p, Float x)            { _mm512_storeu_ps(p, x); }
+        SYMPLE_LANE_TARGET static Float set(float x)                       { return _mm512_set1_ps(x); }
+        SYMPLE_LANE_TARGET static Float add(Float a, Float b)              { return _mm512_add_ps(a, b); }
+        SYMPLE_LANE_TARGET static Float sub(Float a, Float b)              { return _mm512_sub_ps(a, b); }
+        SYMPLE_LANE_TARGET static Float mul(Float a, Float b)              { return _mm512_mul_ps(a, b); }
+        SYMPLE_LANE_TARGET static Float div(Float a, Float b)              { return _mm512_div_ps(a, b); }
+        SYMPLE_LANE_TARGET static Float min(Float a, Float b)              { return _mm512_min_ps(b, a); }
+        SYMPLE_LANE_TARGET static Float max(Float a, Float b)              { return _mm512_max_ps(b, a); }
+        SYMPLE_LANE_TARGET static Mask less(Float a, Float b)              { return _mm512_cmp_ps_mask(a, b, _CMP_LT_OQ); }
+        SYMPLE_LANE_TARGET static Mask greater(Float a, Float b)           { return _mm512_cmp_ps_mask(a, b, _CMP_GT_OQ); }
+        SYMPLE_LANE_TARGET static Float select(Mask m, Float a, Float b)   { return _mm512_mask_blend_ps(m, b, a); }
+        SYMPLE_LANE_TARGET static float sum(Float x)                       { return _mm512_reduce_add_ps(x); }
+
+        SYMPLE_LANE_TARGET static Float floor(Float x)
+        {
+            return _mm512_roundscale_ps(x, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+        }
+
+        SYMPLE_LANE_TARGET static Int loadInt(const uint32_t* p)           { return _mm512_loadu_si512(p); }
+        SYMPLE_LANE_TARGET static void storeInt(uint32_t* p, Int x)        { _mm512_storeu_si512(p, x); }
+        SYMPLE_LANE_TARGET static Float top24BitsToFloat(Int x)            { return _mm512_cvtepi32_ps(_mm512_srli_epi32(x, 8)); }
+
+        SYMPLE_LANE_TARGET static Int xorshift(Int x)
+        {
+            x = _mm512_xor_si512(x, _mm512_slli_epi32(x, 13));
+            x = _mm512_xor_si512(x, _mm512_srli_epi32(x, 17));
+            return _mm512_xor_si512(x, _mm512_slli_epi32(x, 5));
+        }
+    };
+}
+}
+
+#define SYMPLE_LANE_NAMESPACE avx512
+#include "LaneKernelsImpl.h"
+
+const LaneKernels::Table* LaneKernels::getAVX512Table()
+{
+    return &avx512::table;
+}
+
+#else
+
+const LaneKernels::Table* LaneKernels::getAVX512Table()
+{
+    return nullptr;
+}
+
+#endif
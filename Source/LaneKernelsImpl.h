@@ -0,0 +1,269 @@
+/*
+  ==============================================================================
+
+    LaneKernelsImpl.h
+    Created: 19 Oct 2026
+    Author:  woz
+    Notes: Kernel bodies shared by every LaneKernels variant. Deliberately
+           has no include guard: each variant translation unit defines
+
+               SYMPLE_LANE_NAMESPACE   a namespace for its copy of the kernels
+               SYMPLE_LANE_TARGET      the function attribute enabling its isa
+               Vec                     a vector type in that namespace
+
+           and then includes this file once, which leaves a Table called
+           table in LaneKernels::SYMPLE_LANE_NAMESPACE.
+
+           Vec needs Float, Int, Mask, width, level and the static functions
+           used below. Loads and stores are unaligned.
+
+  ==============================================================================
+*/
+
+namespace LaneKernels
+{
+namespace SYMPLE_LANE_NAMESPACE
+{
+    static_assert(numLanes % Vec::width == 0, "lanes must fill whole vectors");
+
+    using Float = Vec::Float;
+
+    // same branch free polyBLEP residual as the scalar VoiceEngine had
+    SYMPLE_LANE_TARGET inline Float polyBlep(Float t, Float dt)
+    {
+        const Float one = Vec::set(1.0f);
+        const Float a = Vec::div(t, dt);
+        const Float b = Vec::div(Vec::sub(t, one), dt);
+        const Float rising = Vec::sub(Vec::sub(Vec::add(a, a), Vec::mul(a, a)), one);
+        const Float falling = Vec::add(Vec::add(Vec::add(Vec::mul(b, b), b), b), one);
+
+        return Vec::select(Vec::less(t, dt), rising,
+                           Vec::select(Vec::greater(t, Vec::sub(one, dt)), falling, Vec::set(0.0f)));
+    }
+
+    /*
+     *  sin(2 pi t) for any phase: folded into a quarter period then a Taylor
+     *  polynomial, which is accurate to about one float ulp there
+     */
+    SYMPLE_LANE_TARGET inline Float sinOfPhase(Float t)
+    {
+        const Float quarter = Vec::set(0.25f);
+        const Float half = Vec::set(0.5f);
+
+        Float u = Vec::sub(t, Vec::floor(Vec::add(t, half)));
+        u = Vec::select(Vec::greater(u, quarter), Vec::sub(half, u), u);
+        u = Vec::select(Vec::less(u, Vec::set(-0.25f)), Vec::sub(Vec::set(-0.5f), u), u);
+
+        const Float x = Vec::mul(Vec::set(juce::MathConstants<float>::twoPi), u);
+        const Float x2 = Vec::mul(x, x);
+
+        Float p = Vec::set(-2.5052108e-8f);
+        p = Vec::add(Vec::set(2.7557319e-6f), Vec::mul(x2, p));
+        p = Vec::add(Vec::set(-1.9841270e-4f), Vec::mul(x2, p));
+        p = Vec::add(Vec::set(8.3333333e-3f), Vec::mul(x2, p));
+        p = Vec::add(Vec::set(-1.6666667e-1f), Vec::mul(x2, p));
+        p = Vec::add(Vec::set(1.0f), Vec::mul(x2, p));
+        return Vec::mul(x, p);
+    }
+
+    // juce::dsp::FastMathApproximations::tanh over the Filter lookup table range
+    SYMPLE_LANE_TARGET inline Float saturate(Float x)
+    {
+        x = Vec::min(Vec::set(5.0f), Vec::max(Vec::set(-5.0f), x));
+        const Float x2 = Vec::mul(x, x);
+
+        const Float numerator = Vec::mul(x, Vec::add(Vec::set(135135.0f),
+                                             Vec::mul(x2, Vec::add(Vec::set(17325.0f),
+                                                                   Vec::mul(x2, Vec::add(Vec::set(378.0f), x2))))));
+        const Float denominator = Vec::add(Vec::set(135135.0f),
+                                           Vec::mul(x2, Vec::add(Vec::set(62370.0f),
+                                                                 Vec::mul(x2, Vec::add(Vec::set(3150.0f),
+                                                                                       Vec::mul(Vec::set(28.0f), x2))))));
+        return Vec::div(numerator, denominator);
+    }
+
+    //==============================================================================
+    template <OscillatorMode Mode>
+    SYMPLE_LANE_TARGET void renderOscillator(float* phase, const float* increment, float* lastOutput, int numSamples, float gain, LaneBuffer out)
+    {
+        const Float gainVector = Vec::set(gain);
+        const Float one = Vec::set(1.0f);
+        const Float half = Vec::set(0.5f);
+
+        for (int lane = 0; lane < numLanes; lane += Vec::width)
+        {
+            Float t = Vec::load(phase + lane);
+            const Float dt = Vec::load(increment + lane);
+            Float last = Vec::load(lastOutput + lane);
+
+            for (int sample = 0; sample < numSamples; ++sample)
+            {
+                Float value = Vec::set(0.0f);
+
+                switch (Mode)
+                {
+                case OSCILLATOR_MODE_SAW:
+                    value = Vec::sub(Vec::set(0.0f), Vec::sub(Vec::sub(Vec::add(t, t), one), polyBlep(t, dt)));
+                    break;
+                case OSCILLATOR_MODE_SINE:
+                    value = sinOfPhase(t);
+                    break;
+                case OSCILLATOR_MODE_SQUARE:
+                case OSCILLATOR_MODE_TRIANGLE:
+                {
+                    Float shifted = Vec::add(t, half);
+                    shifted = Vec::sub(shifted, Vec::floor(shifted));
+                    value = Vec::select(Vec::less(t, half), one, Vec::set(-1.0f));
+                    value = Vec::sub(Vec::add(value, polyBlep(t, dt)), polyBlep(shifted, dt));
+
+                    if (Mode == OSCILLATOR_MODE_TRIANGLE)
+                    {
+                        // Leaky integrator: y[n] = A * x[n] + (1 - A) * y[n-1]
+                        const Float a = Vec::mul(Vec::set(juce::MathConstants<float>::twoPi), dt);
+                        value = Vec::add(Vec::mul(a, value), Vec::mul(Vec::sub(one, a), last));
+                        last = value;
+                    }
+                    break;
+                }
+                case OSCILLATOR_MODE_NOISE:
+                    break;
+                }
+
+                Vec::store(out[sample] + lane, Vec::mul(value, gainVector));
+
+                const Float next = Vec::add(t, dt);
+                t = Vec::sub(next, Vec::floor(next));
+            }
+
+            Vec::store(phase + lane, t);
+            Vec::store(lastOutput + lane, last);
+        }
+    }
+
+    /*
+     *  Adds white noise from a per lane xorshift generator
+     */
+    SYMPLE_LANE_TARGET void renderNoise(uint32_t* state, int numSamples, float gain, LaneBuffer io)
+    {
+        const Float gainVector = Vec::set(gain);
+        const Float scale = Vec::set(2.0f / 16777216.0f);
+        const Float one = Vec::set(1.0f);
+
+        for (int lane = 0; lane < numLanes; lane += Vec::width)
+        {
+            auto x = Vec::loadInt(state + lane);
+
+            for (int sample = 0; sample < numSamples; ++sample)
+            {
+                x = Vec::xorshift(x);
+                const Float noise = Vec::sub(Vec::mul(Vec::top24BitsToFloat(x), scale), one);
+                Vec::store(io[sample] + lane, Vec::add(Vec::load(io[sample] + lane), Vec::mul(noise, gainVector)));
+            }
+
+            Vec::storeInt(state + lane, x);
+        }
+    }
+
+    SYMPLE_LANE_TARGET void renderFilter(const FilterArgs& f, int numSamples, LaneBuffer io)
+    {
+        const Float drive = Vec::set(f.drive);
+        const Float driveGain = Vec::set(f.driveGain);
+        const Float drive2 = Vec::set(f.drive2);
+        const Float driveGain2 = Vec::set(f.driveGain2);
+        const Float feedback = Vec::set(f.scaledResonance * -4.0f);
+        const Float comp = Vec::set(f.comp);
+        const Float m0 = Vec::set(f.mix[0]), m1 = Vec::set(f.mix[1]), m2 = Vec::set(f.mix[2]),
+                    m3 = Vec::set(f.mix[3]), m4 = Vec::set(f.mix[4]);
+
+        for (int lane = 0; lane < numLanes; lane += Vec::width)
+        {
+            Float s0 = Vec::load(f.s[0] + lane), s1 = Vec::load(f.s[1] + lane), s2 = Vec::load(f.s[2] + lane),
+                  s3 = Vec::load(f.s[3] + lane), s4 = Vec::load(f.s[4] + lane);
+            const Float a1 = Vec::load(f.a1 + lane);
+            const Float b0 = Vec::load(f.b0 + lane);
+            const Float b1 = Vec::load(f.b1 + lane);
+
+            for (int sample = 0; sample < numSamples; ++sample)
+            {
+                const Float dx = Vec::mul(driveGain, saturate(Vec::mul(drive, Vec::load(io[sample] + lane))));
+                const Float a = Vec::add(dx, Vec::mul(feedback, Vec::sub(Vec::mul(driveGain2, saturate(Vec::mul(drive2, s4))),
+                                                                         Vec::mul(dx, comp))));
+
+                const Float b = Vec::add(Vec::add(Vec::mul(b1, s0), Vec::mul(a1, s1)), Vec::mul(b0, a));
+                const Float c = Vec::add(Vec::add(Vec::mul(b1, s1), Vec::mul(a1, s2)), Vec::mul(b0, b));
+                const Float d = Vec::add(Vec::add(Vec::mul(b1, s2), Vec::mul(a1, s3)), Vec::mul(b0, c));
+                const Float e = Vec::add(Vec::add(Vec::mul(b1, s3), Vec::mul(a1, s4)), Vec::mul(b0, d));
+
+                s0 = a;
+                s1 = b;
+                s2 = c;
+                s3 = d;
+                s4 = e;
+
+                const Float y = Vec::add(Vec::add(Vec::add(Vec::add(Vec::mul(a, m0), Vec::mul(b, m1)), Vec::mul(c, m2)),
+                                                  Vec::mul(d, m3)), Vec::mul(e, m4));
+                Vec::store(io[sample] + lane, y);
+            }
+
+            Vec::store(f.s[0] + lane, s0);
+            Vec::store(f.s[1] + lane, s1);
+            Vec::store(f.s[2] + lane, s2);
+            Vec::store(f.s[3] + lane, s3);
+            Vec::store(f.s[4] + lane, s4);
+        }
+    }
+
+    SYMPLE_LANE_TARGET void applyEnvelope(LaneBuffer path1, LaneBuffer path2, ConstLaneBuffer envelope, int numSamples)
+    {
+        for (int sample = 0; sample < numSamples; ++sample)
+        {
+            for (int lane = 0; lane < numLanes; lane += Vec::width)
+            {
+                const Float gain = Vec::load(envelope[sample] + lane);
+                Vec::store(path1[sample] + lane, Vec::mul(Vec::load(path1[sample] + lane), gain));
+                Vec::store(path2[sample] + lane, Vec::mul(Vec::load(path2[sample] + lane), gain));
+            }
+        }
+    }
+
+    /*
+     *  Adds the playing lanes of both paths into output. Lanes past
+     *  numPlayingLanes are multiplied by zero rather than skipped.
+     */
+    SYMPLE_LANE_TARGET void mixLanes(ConstLaneBuffer path1, ConstLaneBuffer path2, int numPlayingLanes, int numSamples, float* output)
+    {
+        float playing[numLanes];
+        for (int lane = 0; lane < numLanes; ++lane)
+            playing[lane] = lane < numPlayingLanes ? 1.0f : 0.0f;
+
+        for (int sample = 0; sample < numSamples; ++sample)
+        {
+            Float sum = Vec::set(0.0f);
+
+            for (int lane = 0; lane < numLanes; lane += Vec::width)
+            {
+                const Float voices = Vec::add(Vec::load(path1[sample] + lane), Vec::load(path2[sample] + lane));
+                sum = Vec::add(sum, Vec::mul(voices, Vec::load(playing + lane)));
+            }
+
+            output[sample] += Vec::sum(sum);
+        }
+    }
+
+    const Table table
+    {
+        Vec::level,
+        {
+            &renderOscillator<OSCILLATOR_MODE_SINE>,
+            &renderOscillator<OSCILLATOR_MODE_SAW>,
+            &renderOscillator<OSCILLATOR_MODE_SQUARE>,
+            &renderOscillator<OSCILLATOR_MODE_TRIANGLE>,
+            &renderOscillator<OSCILLATOR_MODE_NOISE>
+        },
+        &renderNoise,
+        &renderFilter,
+        &applyEnvelope,
+        &mixLanes
+    };
+}
+}
@@ -0,0 +1,97 @@
+/*
+  ==============================================================================
+
+    LaneKernelsSSE2.cpp
+    Created: 19 Oct 2026
+    Author:  woz
+
+  ==============================================================================
+*/
+
+#include "LaneKernels.h"
+
+#if JUCE_INTEL
+
+#include <immintrin.h>
+
+#if JUCE_MSVC
+ #define SYMPLE_LANE_TARGET
+#else
+ #define SYMPLE_LANE_TARGET __attribute__ ((target ("sse2")))
+#endif
+
+namespace LaneKernels
+{
+namespace sse2
+{
+    struct Vec
+    {
+        using Float = __m128;
+        using Int = __m128i;
+        using Mask = __m128;
+
+        static constexpr int width = 4;
+        static constexpr SimdLevel level = SimdLevel::SSE2;
+
+        SYMPLE_LANE_TARGET static Float load(const float* p)               { return _mm_loadu_ps(p); }
+        SYMPLE_LANE_TARGET static void store(float* p, Float x)            { _mm_storeu_ps(p, x); }
+        SYMPLE_LANE_TARGET static Float set(float x)                       { return _mm_set1_ps(x); }
+        SYMPLE_LANE_TARGET static Float add(Float a, Float b)              { return _mm_add_ps(a, b); }
+        SYMPLE_LANE_TARGET static Float sub(Float a, Float b)              { return _mm_sub_ps(a, b); }
+        SYMPLE_LANE_TARGET static Float mul(Float a, Float b)              { return _mm_mul_ps(a, b); }
+        SYMPLE_LANE_TARGET static Float div(Float a, Float b)              { return _mm_div_ps(a, b); }
+        SYMPLE_LANE_TARGET static Mask less(Float a, Float b)              { return _mm_cmplt_ps(a, b); }
+        SYMPLE_LANE_TARGET static Mask greater(Float a, Float b)           { return _mm_cmpgt_ps(a, b); }
+
+        // operand order matches std::min and std::max when one side is nan
+        SYMPLE_LANE_TARGET static Float min(Float a, Float b)              { return _mm_min_ps(b, a); }
+        SYMPLE_LANE_TARGET static Float max(Float a, Float b)              { return _mm_max_ps(b, a); }
+
+        SYMPLE_LANE_TARGET static Float select(Mask m, Float a, Float b)
+        {
+            return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b));
+        }
+
+        // SSE2 has no round instruction, truncate and step down for negative values
+        SYMPLE_LANE_TARGET static Float floor(Float x)
+        {
+            const Float truncated = _mm_cvtepi32_ps(_mm_cvttps_epi32(x));
+            return _mm_sub_ps(truncated, _mm_and_ps(_mm_cmpgt_ps(truncated, x), _mm_set1_ps(1.0f)));
+        }
+
+        SYMPLE_LANE_TARGET static float sum(Float x)
+        {
+            const Float pairs = _mm_add_ps(x, _mm_movehl_ps(x, x));
+            return _mm_cvtss_f32(_mm_add_ss(pairs, _mm_shuffle_ps(pairs, pairs, 1)));
+        }
+
+        SYMPLE_LANE_TARGET static Int loadInt(const uint32_t* p)           { return _mm_loadu_si128(reinterpret_cast<const __m128i*> (p)); }
+        SYMPLE_LANE_TARGET static void storeInt(uint32_t* p, Int x)        { _mm_storeu_si128(reinterpret_cast<__m128i*> (p), x); }
+        SYMPLE_LANE_TARGET static Float top24BitsToFloat(Int x)            { return _mm_cvtepi32_ps(_mm_srli_epi32(x, 8)); }
+
+        SYMPLE_LANE_TARGET static Int xorshift(Int x)
+        {
+            x = _mm_xor_si128(x, _mm_slli_epi32(x, 13));
+            x = _mm_xor_si128(x, _mm_srli_epi32(x, 17));
+            return _mm_xor_si128(x, _mm_slli_epi32(x, 5));
+        }
+    };
+}
+}
+
+#define SYMPLE_LANE_NAMESPACE sse2
+#include "LaneKernelsImpl.h"
+
+const LaneKernels::Table* LaneKernels::getSSE2Table()
+{
+    return &sse2::table;
+}
+
+#else
+
+const LaneKernels::Table* LaneKernels::getSSE2Table()
+{
+    return nullptr;
+}
+
+#endif
@@ -0,0 +1,214 @@
+/*
+  ==============================================================================
+
+    MasterEq.cpp
+    Created: 19 Oct 2026
+    Author:  woz
+
+  ==============================================================================
+*/
+
+#include "MasterEq.h"
+
+MasterEq::BandType MasterEq::getBandType(int band)
+{
+    if (band == 0)
+        return BandType::LowShelf;
+
+    return band == numBands - 1 ? BandType::HighShelf : BandType::Peak;
+}
+
+bool MasterEq::isFlat(const Settings& settings)
+{
+    for (auto& band : settings)
+        if (band.gain != 0.0f)
+            return false;
+
+    return true;
+}
+
+//==============================================================================
+/* The shelf and peak filters of the RBJ audio EQ cookbook. Worked out here
+   rather than with juce::dsp::IIR::Coefficients, which allocates */
+void MasterEq::Cascade::setBand(int band, BandType type, const Band& settings, double sampleRate)
+{
+    const double frequency = juce::jlimit(10.0, sampleRate * 0.45, (double)settings.frequency);
+    const double A = std::pow(10.0, settings.gain / 40.0);
+    const double w0 = juce::MathConstants<double>::twoPi * frequency / sampleRate;
+    const double cosw = std::cos(w0);
+    const double q = type == BandType::Peak ? juce::jmax(0.05, (double)settings.q) : 0.7071067811865476;
+    const double alpha = std::sin(w0) / (2.0 * q);
+    const double shelfAlpha = 2.0 * std::sqrt(A) * alpha;
+
+    double c[6]; // b0, b1, b2, a0, a1, a2
+
+    switch (type)
+    {
+    case BandType::LowShelf:
+        c[0] = A * ((A + 1.0) - (A - 1.0) * cosw + shelfAlpha);
+        c[1] = 2.0 * A * ((A - 1.0) - (A + 1.0) * cosw);
+        c[2] = A * ((A + 1.0) - (A - 1.0) * cosw - shelfAlpha);
+        c[3] = (A + 1.0) + (A - 1.0) * cosw + shelfAlpha;
+        c[4] = -2.0 * ((A - 1.0) + (A + 1.0) * cosw);
+        c[5] = (A + 1.0) + (A - 1.0) * cosw - shelfAlpha;
+        break;
+
+    case BandType::HighShelf:
+        c[0] = A * ((A + 1.0) + (A - 1.0) * cosw + shelfAlpha);
+        c[1] = -2.0 * A * ((A - 1.0) + (A + 1.0) * cosw);
+        c[2] = A * ((A + 1.0) + (A - 1.0) * cosw - shelfAlpha);
+        c[3] = (A + 1.0) - (A - 1.0) * cosw + shelfAlpha;
+        c[4] = 2.0 * ((A - 1.0) - (A + 1.0) * cosw);
+        c[5] = (A + 1.0) - (A - 1.0) * cosw - shelfAlpha;
+        break;
+
+    case BandType::Peak:
+    default:
+        c[0] = 1.0 + alpha * A;
+        c[1] = -2.0 * cosw;
+        c[2] = 1.0 - alpha * A;
+        c[3] = 1.0 + alpha / A;
+        c[4] = -2.0 * cosw;
+        c[5] = 1.0 - alpha / A;
+        break;
+    }
+
+    b0[band] = Vec::expand(c[0] / c[3]);
+    b1[band] = Vec::expand(c[1] / c[3]);
+    b2[band] = Vec::expand(c[2] / c[3]);
+    a1[band] = Vec::expand(c[4] / c[3]);
+    a2[band] = Vec::expand(c[5] / c[3]);
+}
+
+void MasterEq::Cascade::clearState()
+{
+    for (int band = 0; band < numBands; ++band)
+        s1[band] = s2[band] = Vec::expand(0.0);
+}
+
+void MasterEq::Cascade::copyStateFrom(const Cascade& other)
+{
+    for (int band = 0; band < numBands; ++band)
+    {
+        s1[band] = other.s1[band];
+        s2[band] = other.s2[band];
+    }
+}
+
+MasterEq::Vec MasterEq::Cascade::process(Vec x)
+{
+    for (int band = 0; band < numBands; ++band)
+    {
+        const auto y = b0[band] * x + s1[band];
+        s1[band] = b1[band] * x - a1[band] * y + s2[band];
+        s2[band] = b2[band] * x - a2[band] * y;
+        x = y;
+    }
+
+    return x;
+}
+
+//==============================================================================
+void MasterEq::prepare(double newSampleRate, int newNumChannels)
+{
+    sampleRate = newSampleRate;
+    numChannels = juce::jmin(newNumChannels, maxChannels);
+    crossfadeLength = juce::jmax(1, juce::roundToInt(crossfadeTime * sampleRate));
+
+    reset();
+}
+
+void MasterEq::reset()
+{
+    // a crossfade in progress is cut short
+    for (int band = 0; band < numBands; ++band)
+        cascades[current].setBand(band, getBandType(band), currentSettings[band], sampleRate);
+
+    for (auto& cascade : cascades)
+        cascade.clearState();
+
+    crossfadeRemaining = 0;
+}
+
+void MasterEq::setParameters(const Settings& settings)
+{
+    if (crossfadeRemaining > 0)
+        return;
+
+    bool changed = false;
+    for (int band = 0; band < numBands; ++band)
+    {
+        const auto& a = settings[band];
+        const auto& b = currentSettings[band];
+        changed = changed || a.frequency != b.frequency || a.gain != b.gain || a.q != b.q;
+    }
+
+    if (!changed)
+        return;
+
+    const bool nowFlat = isFlat(settings);
+    auto& active = cascades[current];
+    auto& next = cascades[1 - current];
+
+    // nothing is heard while flat, so there's nothing to crossfade
+    if (flat && nowFlat)
+    {
+        currentSettings = settings;
+        return;
+    }
+
+    // the active cascade wasn't run while flat
+    if (flat)
+        active.clearState();
+
+    for (int band = 0; band < numBands; ++band)
+        next.setBand(band, getBandType(band), settings[band], sampleRate);
+
+    next.copyStateFrom(active);
+    currentSettings = settings;
+    flat = nowFlat;
+    crossfadeRemaining = crossfadeLength;
+}
+
+void MasterEq::process(juce::AudioBuffer<float>& buffer, int numSamples)
+{
+    const int channels = juce::jmin(numChannels, buffer.getNumChannels());
+    if (channels == 0 || (flat && crossfadeRemaining == 0))
+        return;
+
+    float* data[maxChannels] = {};
+    for (int channel = 0; channel < channels; ++channel)
+        data[channel] = buffer.getWritePointer(channel);
+
+    auto* active = &cascades[current];
+    auto* next = &cascades[1 - current];
+
+    // one frame of every channel, the unused lanes stay at zero
+    alignas(alignof(Vec)) double frame[Vec::SIMDNumElements] = {};
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        for (int channel = 0; channel < channels; ++channel)
+            frame[channel] = data[channel][i];
+
+        const auto x = Vec::fromRawArray(frame);
+        auto y = active->process(x);
+
+        if (crossfadeRemaining > 0)
+        {
+            const auto z = next->process(x);
+            const double position = 1.0 - (crossfadeRemaining - 1) / (double)crossfadeLength;
+            y = y + (z - y) * Vec::expand(position);
+
+            if (--crossfadeRemaining == 0)
+            {
+                current = 1 - current;
+                std::swap(active, next);
+            }
+        }
+
+        y.copyToRawArray(frame);
+        for (int channel = 0; channel < channels; ++channel)
+            data[channel][i] = (float)frame[channel];
+    }
+}
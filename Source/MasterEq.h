@@ -0,0 +1,83 @@
+/*
+  ==============================================================================
+
+    MasterEq.h
+    Created: 19 Oct 2026
+    Author:  woz
+    Notes: Five band EQ on the voice mix: a low shelf, three peaks and a high
+           shelf. The bands are a cascade of transposed direct form II
+           biquads, run on both channels at once with each channel in a lane
+           of a juce SIMD register of doubles.
+
+           Coefficients are only worked out when a band changes. The new
+           cascade then starts from the old one's state and runs beside it
+           while the output crossfades over to it, so sweeps don't click. A
+           change that comes in during a crossfade waits for it to finish.
+           With every gain at 0 dB the cascade is skipped.
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+class MasterEq
+{
+public:
+    static constexpr int numBands = 5;
+    static constexpr int maxChannels = 2;
+
+    enum class BandType { LowShelf, Peak, HighShelf };
+
+    struct Band
+    {
+        float frequency = 1000.0f;
+        float gain = 0.0f;      // dB
+        float q = 0.7071f;
+    };
+
+    using Settings = std::array<Band, numBands>;
+
+    static BandType getBandType(int band);
+
+    void prepare(double sampleRate, int numChannels);
+    void reset();
+
+    /* Starts a crossfade to the new settings if they differ from the
+       current ones and no crossfade is running */
+    void setParameters(const Settings& settings);
+
+    /* Processes the first numSamples of buffer in place */
+    void process(juce::AudioBuffer<float>& buffer, int numSamples);
+
+private:
+    using Vec = juce::dsp::SIMDRegister<double>;
+    static_assert(Vec::SIMDNumElements >= maxChannels, "every channel needs a lane");
+
+    static constexpr float crossfadeTime = 0.02f;
+
+    struct Cascade
+    {
+        Vec b0[numBands], b1[numBands], b2[numBands], a1[numBands], a2[numBands];
+        Vec s1[numBands], s2[numBands];
+
+        void setBand(int band, BandType type, const Band& settings, double sampleRate);
+        void clearState();
+        void copyStateFrom(const Cascade& other);
+        Vec process(Vec x);
+    };
+
+    double sampleRate = 44100.0;
+    int numChannels = 0;
+
+    Cascade cascades[2];
+    int current = 0;
+
+    Settings currentSettings;
+    bool flat = true;
+
+    int crossfadeLength = 1;
+    int crossfadeRemaining = 0;
+
+    static bool isFlat(const Settings&);
+};
@@ -0,0 +1,95 @@
+/*
+  ==============================================================================
+
+    ModulatedDelay.cpp
+    Created: 19 Oct 2026
+    Author:  woz
+
+  ==============================================================================
+*/
+
+#include "ModulatedDelay.h"
+
+void ModulatedDelay::prepare(int maxDelaySamples)
+{
+    const int size = juce::nextPowerOfTwo(maxDelaySamples + maxChunk + 4);
+    buffer.allocate((size_t)size, true);
+    mask = size - 1;
+    writePosition = 0;
+}
+
+void ModulatedDelay::reset()
+{
+    if (buffer != nullptr)
+        juce::FloatVectorOperations::clear(buffer, mask + 1);
+
+    writePosition = 0;
+}
+
+void ModulatedDelay::read(const float* delays, float* output, int numSamples)
+{
+    jassert(numSamples <= maxChunk);
+
+    // gather: the read position for sample i sits behind writePosition + i
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const float delay = juce::jlimit(getMinimumDelay(), getMaximumDelay(), delays[i]);
+        const float position = (float)(writePosition + i) - delay;
+        const float whole = std::floor(position);
+        const int index = (int)whole;
+
+        fraction[i] = position - whole;
+        point0[i] = buffer[(index - 1) & mask];
+        point1[i] = buffer[index & mask];
+        point2[i] = buffer[(index + 1) & mask];
+        point3[i] = buffer[(index + 2) & mask];
+    }
+
+    using Vec = juce::dsp::SIMDRegister<float>;
+    constexpr int width = (int)Vec::SIMDNumElements;
+
+    const auto half = Vec::expand(0.5f);
+    const auto oneAndHalf = Vec::expand(1.5f);
+    const auto two = Vec::expand(2.0f);
+    const auto twoAndHalf = Vec::expand(2.5f);
+
+    int i = 0;
+    for (; i + width <= numSamples; i += width)
+    {
+        const auto y0 = Vec::fromRawArray(point0 + i);
+        const auto y1 = Vec::fromRawArray(point1 + i);
+        const auto y2 = Vec::fromRawArray(point2 + i);
+        const auto y3 = Vec::fromRawArray(point3 + i);
+        const auto t = Vec::fromRawArray(fraction + i);
+
+        const auto c1 = half * (y2 - y0);
+        const auto c2 = y0 - twoAndHalf * y1 + two * y2 - half * y3;
+        const auto c3 = half * (y3 - y0) + oneAndHalf * (y1 - y2);
+
+        const auto value = ((c3 * t + c2) * t + c1) * t + y1;
+
+        alignas(16) float result[width];
+        value.copyToRawArray(result);
+        std::copy(result, result + width, output + i);
+    }
+
+    for (; i < numSamples; ++i)
+    {
+        const float y0 = point0[i], y1 = point1[i], y2 = point2[i], y3 = point3[i], t = fraction[i];
+        const float c1 = 0.5f * (y2 - y0);
+        const float c2 = y0 - 2.5f * y1 + 2.0f * y2 - 0.5f * y3;
+        const float c3 = 0.5f * (y3 - y0) + 1.5f * (y1 - y2);
+        output[i] = ((c3 * t + c2) * t + c1) * t + y1;
+    }
+}
+
+void ModulatedDelay::write(const float* input, int numSamples)
+{
+    const int size = mask + 1;
+    const int first = juce::jmin(numSamples, size - writePosition);
+
+    juce::FloatVectorOperations::copy(buffer + writePosition, input, first);
+    juce::FloatVectorOperations::copy(buffer, input + first, numSamples - first);
+
+    writePosition = (writePosition + numSamples) & mask;
+}
@@ -0,0 +1,55 @@
+/*
+  ==============================================================================
+
+    ModulatedDelay.h
+    Created: 19 Oct 2026
+    Author:  woz
+    Notes: The ring buffer under the chorus and the tempo delay. Its size is
+           a power of two so positions wrap with a mask, and it is read at
+           fractional delays with 4 point Catmull-Rom interpolation.
+
+           Reads and writes go in chunks of at most maxChunk samples. The
+           four neighbours of each read are gathered into scratch arrays,
+           and the interpolation then runs over those with juce SIMD
+           registers. Every delay must be longer than the chunk being read,
+           so a chunk is read before it is written.
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+class ModulatedDelay
+{
+public:
+    static constexpr int maxChunk = 32;
+
+    /* Allocates room for at least maxDelaySamples. Not realtime safe */
+    void prepare(int maxDelaySamples);
+    void reset();
+
+    /* The longest delay read() accepts, in samples */
+    float getMaximumDelay() const { return (float)(mask - 3); }
+
+    /* The shortest, which keeps every read behind the chunk being written */
+    static constexpr float getMinimumDelay() { return (float)(maxChunk + 3); }
+
+    /* Reads numSamples at the given delays in samples, each measured from
+       the sample that will be written at the same position of the chunk */
+    void read(const float* delays, float* output, int numSamples);
+
+    void write(const float* input, int numSamples);
+
+private:
+    juce::HeapBlock<float> buffer;
+    int mask = 0;
+    int writePosition = 0;
+
+    // the interpolation points of a chunk, laid out for SIMD loads
+    alignas(16) float point0[maxChunk];
+    alignas(16) float point1[maxChunk];
+    alignas(16) float point2[maxChunk];
+    alignas(16) float point3[maxChunk];
+    alignas(16) float fraction[maxChunk];
+};
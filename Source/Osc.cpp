@@ -35,6 +35,11 @@ void Oscillator::setSampleRate(double sampleRate) {
     updateIncrement();
 }
 
+void Oscillator::setPhaseIncrement(double increment) {
+    mPhaseIncrement = increment;
+    mFrequency = increment * mSampleRate / (2 * mPI);
+}
+
 void Oscillator::updateIncrement() {
     mPhaseIncrement = mFrequency * 2 * mPI / mSampleRate;
 }
@@ -45,81 +50,29 @@ void Oscillator::startNote() {
 
 void Oscillator::generate(juce::dsp::AudioBlock<float>& buffer, int numSamples, double gain)
 {
-    double waveSegment = 0.0;
-    
+    const double gainValue = juce::Decibels::decibelsToGain(gain);
+
+    switch (mOscillatorMode)
+    {
+    case OSCILLATOR_MODE_SAW:       generateMode<OSCILLATOR_MODE_SAW>(buffer, numSamples, gainValue);       break;
+    case OSCILLATOR_MODE_SINE:      generateMode<OSCILLATOR_MODE_SINE>(buffer, numSamples, gainValue);      break;
+    case OSCILLATOR_MODE_SQUARE:    generateMode<OSCILLATOR_MODE_SQUARE>(buffer, numSamples, gainValue);    break;
+    case OSCILLATOR_MODE_TRIANGLE:  generateMode<OSCILLATOR_MODE_TRIANGLE>(buffer, numSamples, gainValue);  break;
+    case OSCILLATOR_MODE_NOISE:     generateMode<OSCILLATOR_MODE_NOISE>(buffer, numSamples, gainValue);     break;
+    }
+}
+
+template <OscillatorMode Mode>
+void Oscillator::generateMode(juce::dsp::AudioBlock<float>& buffer, int numSamples, double gainValue)
+{
     for (int sample = 0; sample < numSamples; sample++)
     {
-        polyBlepPhase = mPhase / twoPI;
-        switch (mOscillatorMode)
-        {
-        case OSCILLATOR_MODE_SAW:
-            waveSegment = (2.0 * mPhase / twoPI) - 1.0; // naive wave
-            waveSegment -= polyBlep(polyBlepPhase);
-            waveSegment *= -1;
-            break;
-        case OSCILLATOR_MODE_SINE:
-            waveSegment = sin(mPhase);
-            break;
-        case OSCILLATOR_MODE_SQUARE:
-            if (mPhase < mPI)
-            {
-                waveSegment = 1.0;
-            }
-            else
-            {
-                waveSegment = -1.0;
-            }
-            waveSegment += polyBlep(polyBlepPhase);
-            waveSegment -= polyBlep(fmod(polyBlepPhase + 0.5, 1.0));
-            break;
-        case OSCILLATOR_MODE_TRIANGLE:
-            if (mPhase < mPI)
-            {
-                waveSegment = 1.0;
-            }
-            else
-            {
-                waveSegment = -1.0;
-            }
-            waveSegment += polyBlep(polyBlepPhase);
-            waveSegment -= polyBlep(fmod(polyBlepPhase + 0.5, 1.0));
-            // Leaky integrator: y[n] = A * x[n] + (1 - A) * y[n-1]
-            waveSegment = mPhaseIncrement * waveSegment + (1 - mPhaseIncrement) * lastOutput;
-            lastOutput = waveSegment;
-                break;
-        case OSCILLATOR_MODE_NOISE:
-            waveSegment = random.nextFloat() * 2.0f - 1.0f;
-        }
+        double waveSegment = nextSample<Mode>();
 
         // copy the same sample into all channels for mono sound
         for (int channel = 0; channel < buffer.getNumChannels(); channel++)
         {
-            buffer.addSample(channel, sample, (float)waveSegment * juce::Decibels::decibelsToGain(gain));
+            buffer.addSample(channel, sample, (float)waveSegment * gainValue);
         }
-            
-        mPhase += mPhaseIncrement;
-        while (mPhase >= twoPI)
-        {
-            mPhase -= twoPI;
-        }
-    }
-}
-
-double Oscillator::polyBlep(double t)
-{
-    double dt = mPhaseIncrement / twoPI;
-    // 0 <= t < 1
-    if (t < dt)
-    {
-        t /= dt;
-        return t+t - t*t - 1.0;
-    }
-    // -1 < t < 0
-    else if (t > 1.0 - dt)
-    {
-        t = (t - 1.0) / dt;
-        return t*t + t+t + 1.0;
     }
-    // 0 otherwise
-    else return 0.0;
 }
@@ -25,24 +25,86 @@ enum OscillatorMode {
 
 class Oscillator {
 private:
-    double polyBlep(double);
     double lastOutput;
-    double polyBlepPhase;
     juce::Random random;
 
+    template <OscillatorMode Mode>
+    void generateMode(juce::dsp::AudioBlock<float>&, int nFrames, double gainValue);
+
 public:
     void setMode(OscillatorMode mode);
+    OscillatorMode getMode() const { return mOscillatorMode; }
     void setFrequency(double frequency);
     void setSampleRate(double sampleRate);
+
+    /* Sets the frequency as radians per sample, taken from a RateContext */
+    void setPhaseIncrement(double increment);
     void startNote();
+
+    /* Turns the polyBLEP correction off for the cheap naive waveforms */
+    void setBandLimited(bool shouldBandLimit) { bandLimited = shouldBandLimit; }
     void generate(juce::dsp::AudioBlock<float>&, int nFrames, double gain);
+
+    /* Returns the next sample of a fixed waveform and advances the phase.
+       The mode is a template argument so fused voice kernels can inline it */
+    template <OscillatorMode Mode>
+    double nextSample()
+    {
+        double waveSegment = 0.0;
+        const double polyBlepPhase = mPhase / twoPI;
+
+        switch (Mode)
+        {
+        case OSCILLATOR_MODE_SAW:
+            waveSegment = (2.0 * mPhase / twoPI) - 1.0; // naive wave
+            if (bandLimited)
+                waveSegment -= polyBlep(polyBlepPhase);
+            waveSegment *= -1;
+            break;
+        case OSCILLATOR_MODE_SINE:
+            waveSegment = sin(mPhase);
+            break;
+        case OSCILLATOR_MODE_SQUARE:
+            waveSegment = mPhase < mPI ? 1.0 : -1.0;
+            if (bandLimited)
+            {
+                waveSegment += polyBlep(polyBlepPhase);
+                waveSegment -= polyBlep(fmod(polyBlepPhase + 0.5, 1.0));
+            }
+            break;
+        case OSCILLATOR_MODE_TRIANGLE:
+            waveSegment = mPhase < mPI ? 1.0 : -1.0;
+            if (bandLimited)
+            {
+                waveSegment += polyBlep(polyBlepPhase);
+                waveSegment -= polyBlep(fmod(polyBlepPhase + 0.5, 1.0));
+            }
+            // Leaky integrator: y[n] = A * x[n] + (1 - A) * y[n-1]
+            waveSegment = mPhaseIncrement * waveSegment + (1 - mPhaseIncrement) * lastOutput;
+            lastOutput = waveSegment;
+            break;
+        case OSCILLATOR_MODE_NOISE:
+            waveSegment = random.nextFloat() * 2.0f - 1.0f;
+            break;
+        }
+
+        mPhase += mPhaseIncrement;
+        while (mPhase >= twoPI)
+        {
+            mPhase -= twoPI;
+        }
+
+        return waveSegment;
+    }
+
     Oscillator() :
     mOscillatorMode(OSCILLATOR_MODE_SAW),
     mPI(2*acos(0.0)),
     twoPI(2 * mPI),
     mFrequency(440.0),
     lastOutput(0.0),
-    mPhase(0.0) { updateIncrement(); }; // TODO: This could be an issue if the user or DAW is set to a different sample rate.
+    mPhase(0.0),
+    mSampleRate(44100.0) { updateIncrement(); }; // the owner sets the real rate before the first note
     
 //    ~Oscillator();
 protected:
@@ -54,6 +116,26 @@ protected:
     double mPhase;
     double mSampleRate;
     double mPhaseIncrement;
+    bool bandLimited = true;
     
     void updateIncrement();
+
+    double polyBlep(double t) const
+    {
+        double dt = mPhaseIncrement / twoPI;
+        // 0 <= t < 1
+        if (t < dt)
+        {
+            t /= dt;
+            return t+t - t*t - 1.0;
+        }
+        // -1 < t < 0
+        else if (t > 1.0 - dt)
+        {
+            t = (t - 1.0) / dt;
+            return t*t + t+t + 1.0;
+        }
+        // 0 otherwise
+        else return 0.0;
+    }
 };
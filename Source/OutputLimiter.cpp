@@ -0,0 +1,232 @@
+/*
+  ==============================================================================
+
+    OutputLimiter.cpp
+    Created: 19 Oct 2026
+    Author:  woz
+
+  ==============================================================================
+*/
+
+#include "OutputLimiter.h"
+
+void SlidingMaximum::prepare(int windowLength)
+{
+    window = (juce::uint32)juce::jmax(1, windowLength);
+
+    // the deque never holds more than a window of values
+    const int size = juce::nextPowerOfTwo((int)window + 1);
+    values.allocate((size_t)size, true);
+    times.allocate((size_t)size, true);
+    mask = (juce::uint32)size - 1;
+
+    reset();
+}
+
+void SlidingMaximum::reset()
+{
+    head = tail = now = 0;
+}
+
+float SlidingMaximum::push(float value) noexcept
+{
+    // values no larger than the new one can never be the maximum again
+    while (tail != head && values[(tail - 1) & mask] <= value)
+        --tail;
+
+    values[tail & mask] = value;
+    times[tail & mask] = now;
+    ++tail;
+
+    // the window moves on by one, so at most the oldest value leaves it
+    if (now - times[head & mask] >= window)
+        ++head;
+
+    ++now;
+    return values[head & mask];
+}
+
+//==============================================================================
+void OutputLimiter::prepare(double sampleRate, int newNumChannels)
+{
+    numChannels = juce::jmin(newNumChannels, maxChannels);
+
+    oversampling = std::make_unique<juce::dsp::Oversampling<float>>(juce::jmax(1, numChannels), 1,
+        juce::dsp::Oversampling<float>::filterHalfBandFIREquiripple, true);
+    oversampling->initProcessing(chunkSize);
+
+    releaseCoefficient = 1.0f - std::exp(-1.0f / (releaseTime * (float)sampleRate));
+
+    lookahead = juce::jmax(1, juce::roundToInt(lookaheadTime * sampleRate));
+    peakWindow.prepare(lookahead);
+    heldGain.allocate((size_t)lookahead, false);
+
+    // the gain for a sample is ready once its peak has been through the
+    // interpolator and a whole lookahead window has passed it
+    limiterDelay = peakDelay + lookahead - 1;
+    const int delaySize = juce::nextPowerOfTwo(limiterDelay + 1);
+    delayLine.setSize(juce::jmax(1, numChannels), delaySize);
+    delayMask = delaySize - 1;
+
+    latency = juce::roundToInt(oversampling->getLatencyInSamples()) + limiterDelay;
+
+    // a Blackman windowed sinc for each fractional phase, stored reversed so
+    // the oldest sample of the history meets the first coefficient
+    for (int phase = 1; phase < peakPhases; ++phase)
+    {
+        const double fraction = phase / (double)peakPhases;
+        const double halfWidth = peakTaps / 2 + 1;
+        double coefficients[peakTaps];
+        double sum = 0.0;
+
+        for (int tap = 0; tap < peakTaps; ++tap)
+        {
+            const double t = tap - peakDelay + fraction;
+            const double x = juce::MathConstants<double>::pi * t;
+            const double w = juce::MathConstants<double>::pi * t / halfWidth;
+            const double sinc = std::abs(x) < 1.0e-9 ? 1.0 : std::sin(x) / x;
+
+            coefficients[tap] = sinc * (0.42 + 0.5 * std::cos(w) + 0.08 * std::cos(2.0 * w));
+            sum += coefficients[tap];
+        }
+
+        for (int tap = 0; tap < peakTaps; ++tap)
+            peakCoefficients[phase - 1][peakTaps - 1 - tap] = (float)(coefficients[tap] / sum);
+    }
+
+    reset();
+}
+
+void OutputLimiter::reset()
+{
+    if (oversampling != nullptr)
+        oversampling->reset();
+
+    for (auto& history : peakHistory)
+        std::fill(std::begin(history), std::end(history), 0.0f);
+
+    peakPosition = 0;
+    peakWindow.reset();
+
+    if (heldGain != nullptr)
+        std::fill(heldGain.get(), heldGain.get() + lookahead, 1.0f);
+
+    heldPosition = 0;
+    heldSum = lookahead;
+    gain = 1.0f;
+
+    delayLine.clear();
+    delayPosition = 0;
+}
+
+void OutputLimiter::setParameters(bool shouldBeEnabled, float ceilingDecibels)
+{
+    enabled = shouldBeEnabled;
+    ceiling = juce::Decibels::decibelsToGain(ceilingDecibels);
+}
+
+void OutputLimiter::clip(juce::dsp::AudioBlock<float>& block)
+{
+    const auto& saturation = tables->getSaturation<float>();
+    const float range = ceiling * (clipHeadroom - 1.0f);
+
+    for (size_t channel = 0; channel < block.getNumChannels(); ++channel)
+    {
+        float* samples = block.getChannelPointer(channel);
+
+        for (size_t i = 0; i < block.getNumSamples(); ++i)
+        {
+            const float level = std::abs(samples[i]);
+            if (level > ceiling)
+                samples[i] = std::copysign(ceiling + range * saturation((level - ceiling) / range), samples[i]);
+        }
+    }
+}
+
+float OutputLimiter::getTruePeak(int channel, float input) noexcept
+{
+    // the history is written twice so the newest peakTaps samples are
+    // always contiguous
+    float* history = peakHistory[channel];
+    history[peakPosition] = input;
+    history[peakPosition + peakHistorySize] = input;
+
+    const float* x = history + peakPosition + peakHistorySize - (peakTaps - 1);
+    float peak = std::abs(x[peakTaps - 1 - peakDelay]);
+
+    for (int phase = 0; phase < peakPhases - 1; ++phase)
+    {
+        float value = 0.0f;
+        for (int tap = 0; tap < peakTaps; ++tap)
+            value += peakCoefficients[phase][tap] * x[tap];
+
+        peak = juce::jmax(peak, std::abs(value));
+    }
+
+    return peak;
+}
+
+float OutputLimiter::getNextGain(float peak) noexcept
+{
+    const float limit = ceiling * peakMargin;
+    const float held = peakWindow.push(peak);
+    const float target = held > limit ? limit / held : 1.0f;
+
+    heldSum += target - heldGain[heldPosition];
+    heldGain[heldPosition] = target;
+    if (++heldPosition == lookahead)
+        heldPosition = 0;
+
+    // the average is already a ramp down, only the release is smoothed
+    const float average = (float)(heldSum / lookahead);
+    if (average < gain)
+        gain = average;
+    else
+        gain += (average - gain) * releaseCoefficient;
+
+    return gain;
+}
+
+void OutputLimiter::process(juce::AudioBuffer<float>& buffer, int numSamples)
+{
+    const int channels = juce::jmin(numChannels, buffer.getNumChannels());
+    if (channels == 0)
+        return;
+
+    juce::dsp::AudioBlock<float> output (buffer);
+    output = output.getSubsetChannelBlock(0, (size_t)channels);
+
+    for (int start = 0; start < numSamples; start += chunkSize)
+    {
+        const int n = juce::jmin(chunkSize, numSamples - start);
+        auto block = output.getSubBlock((size_t)start, (size_t)n);
+
+        auto oversampled = oversampling->processSamplesUp(block);
+        if (enabled)
+            clip(oversampled);
+        oversampling->processSamplesDown(block);
+
+        for (int i = 0; i < n; ++i)
+        {
+            float peak = 0.0f;
+            for (int channel = 0; channel < channels; ++channel)
+                peak = juce::jmax(peak, getTruePeak(channel, block.getSample(channel, i)));
+
+            peakPosition = (peakPosition + 1) & (peakHistorySize - 1);
+
+            // the gain keeps following the signal while off, so switching
+            // back on starts from the right place
+            const float sampleGain = getNextGain(peak);
+            const float appliedGain = enabled ? sampleGain : 1.0f;
+
+            for (int channel = 0; channel < channels; ++channel)
+            {
+                float* line = delayLine.getWritePointer(channel);
+                line[delayPosition] = block.getSample(channel, i);
+                block.setSample(channel, i, line[(delayPosition - limiterDelay) & delayMask] * appliedGain);
+            }
+
+            delayPosition = (delayPosition + 1) & delayMask;
+        }
+    }
+}
@@ -0,0 +1,123 @@
+/*
+  ==============================================================================
+
+    OutputLimiter.h
+    Created: 19 Oct 2026
+    Author:  woz
+    Notes: The last stage of the chain, which keeps the output under a true
+           peak ceiling in two steps:
+
+               clipper   soft clips at 2x oversampling. Samples under the
+                         ceiling pass untouched, louder ones are bent with
+                         tanh towards 3 dB over it
+               limiter   lookahead gain from the true peaks of the clipped
+                         signal, read at 4x between samples
+
+           The limiter holds the highest true peak of the lookahead window
+           with a SlidingMaximum, then averages the held gain over the same
+           window. The gain has then ramped all the way down by the time the
+           peak is output. Releases are a one pole glide.
+
+           Material that is mostly near Nyquist, such as full band noise far
+           over the ceiling, can still read a few tenths of a dB over on a
+           longer interpolator than the limiter's.
+
+           Switching the stage off bypasses the clipping and the gain but
+           not the latency, so the host's delay compensation stays right.
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "DspTables.h"
+
+/* The largest of the last windowLength values pushed, at amortised O(1) cost
+   per push: a monotonic deque of the values that can still become the
+   maximum, kept in a power of two ring */
+class SlidingMaximum
+{
+public:
+    /* Allocates the ring. Not realtime safe */
+    void prepare(int windowLength);
+    void reset();
+
+    /* Adds a value and returns the maximum of the window that ends with it */
+    float push(float value) noexcept;
+
+private:
+    juce::HeapBlock<float> values;
+    juce::HeapBlock<juce::uint32> times;
+    juce::uint32 mask = 0;
+    juce::uint32 head = 0, tail = 0;    // the deque is [head, tail)
+    juce::uint32 now = 0;
+    juce::uint32 window = 1;
+};
+
+class OutputLimiter
+{
+public:
+    static constexpr int maxChannels = 2;
+    static constexpr int chunkSize = 64;
+
+    /* Builds the oversampler and buffers for the rate. Not realtime safe */
+    void prepare(double sampleRate, int numChannels);
+    void reset();
+
+    /* Samples of delay the stage adds, to report to the host */
+    int getLatencySamples() const { return latency; }
+
+    void setParameters(bool enabled, float ceilingDecibels);
+
+    /* Processes the first numSamples of buffer in place */
+    void process(juce::AudioBuffer<float>& buffer, int numSamples);
+
+private:
+    static constexpr float lookaheadTime = 0.002f;
+    static constexpr float releaseTime = 0.08f;
+    static constexpr float clipHeadroom = 1.4125375f;   // +3 dB
+
+    // true peaks are interpolated with a 4 phase windowed sinc of 32 taps
+    // per phase, whose output lags the input by peakDelay samples. Shorter
+    // kernels roll off early and under read peaks near Nyquist
+    static constexpr int peakTaps = 32;
+    static constexpr int peakPhases = 4;
+    static constexpr int peakDelay = peakTaps / 2;
+    static constexpr int peakHistorySize = 32;
+
+    // the gain aims this far under the ceiling, as other 4x meters
+    // interpolate a little differently
+    static constexpr float peakMargin = 0.99426f;   // -0.05 dB
+
+    juce::SharedResourcePointer<DspTables> tables;
+    std::unique_ptr<juce::dsp::Oversampling<float>> oversampling;
+
+    int numChannels = 0;
+    int latency = 0;
+    bool enabled = true;
+    float ceiling = 1.0f;
+    float releaseCoefficient = 0.0f;
+
+    float peakCoefficients[peakPhases - 1][peakTaps];
+    float peakHistory[maxChannels][peakHistorySize * 2];
+    int peakPosition = 0;
+
+    SlidingMaximum peakWindow;
+    int lookahead = 1;
+
+    // the held gain of the lookahead window and its running sum
+    juce::HeapBlock<float> heldGain;
+    int heldPosition = 0;
+    double heldSum = 0.0;
+    float gain = 1.0f;
+
+    // the signal waits here for its gain
+    juce::AudioBuffer<float> delayLine;
+    int delayMask = 0;
+    int delayPosition = 0;
+    int limiterDelay = 0;
+
+    void clip(juce::dsp::AudioBlock<float>& block);
+    float getTruePeak(int channel, float input) noexcept;
+    float getNextGain(float peak) noexcept;
+};
@@ -22,6 +22,9 @@ SympleSynthAudioProcessorEditor::SympleSynthAudioProcessorEditor (SympleSynthAud
       filter2(p),
       amplifier(p),
       lfo(p)
+     #if SYMPLE_PROFILING
+      , profilerOverlay(p.getProfiler())
+     #endif
 {
     // Set Look & Feel
     setLookAndFeel(&sympleLook);
@@ -130,6 +133,10 @@ SympleSynthAudioProcessorEditor::SympleSynthAudioProcessorEditor (SympleSynthAud
     ampLabel.setLookAndFeel(&labelLook);
     lfoLabel.setLookAndFeel(&labelLook);
 
+   #if SYMPLE_PROFILING
+    // drawn over the top right corner, on top of everything else
+    addAndMakeVisible(profilerOverlay);
+   #endif
 
     setSize (1200, 800);
     
@@ -179,6 +186,10 @@ void SympleSynthAudioProcessorEditor::resized()
     amplifier.setBounds(ampArea.removeFromTop(componentHeight).reduced(margin));
     lfo.setBounds(ampArea.removeFromTop(componentHeight).reduced(margin));
 
+   #if SYMPLE_PROFILING
+    profilerOverlay.setBounds(getLocalBounds().removeFromRight(260).removeFromTop(270).reduced(4));
+   #endif
+
 //    noise.setBounds(componentWidth - (componentWidth / 8) - (margin / 2),
 //                    componentHeight,
 //                    (componentWidth / 4) + margin,
@@ -17,6 +17,7 @@
 #include "LfoInterface.h"
 #include "SympleLookAndFeel.h"
 #include "NoiseOscInterface.h"
+#include "ProfilerOverlay.h"
 
 //==============================================================================
 /**
@@ -66,5 +67,9 @@ private:
     juce::Label ampLabel;
     juce::Label lfoLabel;
 
+   #if SYMPLE_PROFILING
+    ProfilerOverlay profilerOverlay;
+   #endif
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SympleSynthAudioProcessorEditor)
 };
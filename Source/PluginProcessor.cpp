@@ -10,6 +10,7 @@
 
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
+#include "PluginState.h"
 
 //==============================================================================
 SympleSynthAudioProcessor::SympleSynthAudioProcessor()
@@ -21,18 +22,22 @@ SympleSynthAudioProcessor::SympleSynthAudioProcessor()
                       #endif
                        .withOutput ("Output", juce::AudioChannelSet::stereo(), true)
                      #endif
-                       ), tree(*this, nullptr, "PARAMETERS", createParameters())
+                       ), tree(*this, nullptr, "PARAMETERS", createParameters()),
+                         voiceEngine(tree), presetBank(tree),
+                         blockTimeMonitor(getParameters())
 #endif
 {
     // initialize the synth with x number of voices
-    synth.clearVoices();
-    for (int i = 0; i < VOICE_COUNT; ++i)
-    {
-        synth.addVoice(new SynthVoice(tree, lfoBuffer));
-    }
+    voiceEnginePolyphony = voiceEngine.getPolyphony();
+    setNumVoices(VOICE_COUNT);
 
     synth.clearSounds();
     synth.addSound(new SynthSound());
+
+    presetBank.open(PresetBank::getDefaultBankFile());
+   #if SYMPLE_BLOCK_TIMING_DUMPS
+    blockTimeMonitor.startDumping(BlockTimeMonitor::getDefaultDumpFile());
+   #endif
 }
 
 SympleSynthAudioProcessor::~SympleSynthAudioProcessor()
@@ -72,29 +77,38 @@ bool SympleSynthAudioProcessor::isMidiEffect() const
    #endif
 }
 
+/* The reverb's impulse response plus the delay's repeats, so hosts don't cut
+   either off. The delay is timed with the tempo of the last block */
 double SympleSynthAudioProcessor::getTailLengthSeconds() const
 {
-    return 0.0;
+    const double beats = DelayDivisions::getBeats(tree.getRawParameterValue("DELAY_TIME")->load());
+    const double delayTime = juce::jmin((double)TempoDelay::maxDelayTime, beats * 60.0 / hostTempo.load());
+    const float feedback = tree.getRawParameterValue("DELAY_FEEDBACK")->load() / 100.0f;
+
+    return reverb.getTailLengthSeconds() + TempoDelay::getTailLengthSeconds(delayTime, feedback);
 }
 
 int SympleSynthAudioProcessor::getNumPrograms()
 {
-    return 1;   // NB: some hosts don't cope very well if you tell them there are 0 programs,
-                // so this should be at least 1, even if you're not really implementing programs.
+    // NB: some hosts don't cope very well if you tell them there are 0 programs,
+    // so this should be at least 1, even if there is no preset bank.
+    return juce::jmax(1, presetBank.getNumPresets());
 }
 
 int SympleSynthAudioProcessor::getCurrentProgram()
 {
-    return 0;
+    return presetBank.getCurrentPreset();
 }
 
 void SympleSynthAudioProcessor::setCurrentProgram (int index)
 {
+    // the preset is loaded in the background and applied at the next block
+    presetBank.requestPreset(index);
 }
 
 const juce::String SympleSynthAudioProcessor::getProgramName (int index)
 {
-    return {};
+    return presetBank.getName(index);
 }
 
 void SympleSynthAudioProcessor::changeProgramName (int index, const juce::String& newName)
@@ -109,22 +123,135 @@ void SympleSynthAudioProcessor::prepareToPlay (double sampleRate, int samplesPer
     juce::ignoreUnused(samplesPerBlock); // clear out any unused samples from last key press
     lastSampleRate = sampleRate; // this is in case the sample rate is changed while the synth is being used so it doesn't 
     synth.setCurrentPlaybackSampleRate(lastSampleRate);
+
+    // usually built in the background already, this only waits for a new rate
+    rateContext.store(rateContexts->getContext(sampleRate));
     
     // prepare lfo
     lfo.setSampleRate(sampleRate);
     lfo.setFrequency(tree.getRawParameterValue("LFO_FREQUENCY")->load());
-    int oscMode = tree.getParameterAsValue("LFO_WAVE_TYPE").getValue();
+    int oscMode = juce::roundToInt(tree.getRawParameterValue("LFO_WAVE_TYPE")->load());
     lfo.setMode(static_cast<OscillatorMode> (oscMode));
-    lfoBuffer = juce::dsp::AudioBlock<float> (heapBlock, 1, samplesPerBlock);
+
+    // everything after this point works in sub-blocks, so the voices and lfo
+    // only need room for one oversampled sub-block whatever the host sends
+    const int maxVoiceBlockSize = subBlockSize * RenderQualityTiers::maxOversamplingFactor;
+    lfoBuffer = juce::dsp::AudioBlock<float> (heapBlock, 1, maxVoiceBlockSize);
     lfoBuffer.clear();
+
+    static_assert(RenderQualityTiers::maxOversamplingFactor == 2, "the oversampler is built for 2x");
+    oversampling = std::make_unique<juce::dsp::Oversampling<float>>(getTotalNumOutputChannels(), 1,
+        juce::dsp::Oversampling<float>::filterHalfBandPolyphaseIIR, true);
+    oversampling->initProcessing(subBlockSize);
+    subBlockMidi.ensureSize(8192);
     
     // prepare voices with buffer/sample rate
     juce::dsp::ProcessSpec spec;
     spec.sampleRate = sampleRate;
-    spec.maximumBlockSize = samplesPerBlock;
+    spec.maximumBlockSize = maxVoiceBlockSize;
     spec.numChannels = getTotalNumOutputChannels();
     
+    voiceSpec = spec;
     prepareVoices(spec);
+    appliedVoiceRate = 0.0;
+    applyRenderQuality(getRequestedQuality());
+    updateVoiceRenderPool(true);
+    governor.reset();
+    applyGovernorLevel(0);
+
+    masterEq.setParameters(getEqSettings());
+    masterEq.prepare(sampleRate, getTotalNumOutputChannels());
+    chorus.prepare(sampleRate, getTotalNumOutputChannels());
+    tempoDelay.prepare(sampleRate, getTotalNumOutputChannels());
+
+    reverb.setRoomSize(tree.getRawParameterValue("REVERB_SIZE")->load());
+    reverb.setSynchronous(isNonRealtime());
+    reverb.prepare(sampleRate, getTotalNumOutputChannels(), tree.getRawParameterValue("REVERB_MIX")->load() / 100.0f);
+    limiter.prepare(sampleRate, getTotalNumOutputChannels());
+
+    // a tier picked during playback keeps this latency until the next prepare
+    const int voiceLatency = oversamplingFactor > 1 ? juce::roundToInt(oversampling->getLatencyInSamples()) : 0;
+    setLatencySamples(voiceLatency + limiter.getLatencySamples());
+}
+
+/* Non-realtime renders ignore QUALITY and always get the Offline tier */
+RenderQuality SympleSynthAudioProcessor::getRequestedQuality()
+{
+    if (isNonRealtime())
+        return RenderQuality::Offline;
+
+    return RenderQualityTiers::fromParameter(tree.getRawParameterValue("QUALITY")->load());
+}
+
+/*
+ *  Sets the voices, lfo and voice engine up for a quality tier with the rates
+ *  of the current RateContext. Runs at the start of a block when QUALITY or
+ *  the context changes, so it must not allocate. Changing the oversampling
+ *  factor changes the voice rate, which stops every note. Tiers at the same
+ *  rate, such as Eco and Normal, keep the notes playing.
+ */
+void SympleSynthAudioProcessor::applyRenderQuality(RenderQuality quality)
+{
+    renderQuality = quality;
+    const auto settings = RenderQualityTiers::getSettings(quality);
+    oversamplingFactor = settings.oversamplingFactor;
+
+    appliedRateContext = rateContext.load();
+    const auto& rates = appliedRateContext->getVoiceRates(quality);
+
+    const double voiceRate = rates.sampleRate;
+    synth.setCurrentPlaybackSampleRate(voiceRate);
+    lfo.setSampleRate(voiceRate);
+
+    for (int i = 0; i < synth.getNumVoices(); ++i)
+        dynamic_cast<SynthVoice*>(synth.getVoice(i))->setRenderQuality(settings, rates);
+
+    if (voiceRate != appliedVoiceRate)
+    {
+        auto engineSpec = voiceSpec;
+        engineSpec.sampleRate = voiceRate;
+        voiceEngine.prepare(engineSpec);
+
+        oversampling->reset();
+        appliedVoiceRate = voiceRate;
+    }
+}
+
+/* The bands of the EQ_ parameters, low shelf first */
+MasterEq::Settings SympleSynthAudioProcessor::getEqSettings()
+{
+    // literals, so nothing is allocated on the audio thread
+    static const char* const bandIds[MasterEq::numBands][3] =
+    {
+        { "EQ_LOW_FREQ",    "EQ_LOW_GAIN",    nullptr },
+        { "EQ_PEAK_1_FREQ", "EQ_PEAK_1_GAIN", "EQ_PEAK_1_Q" },
+        { "EQ_PEAK_2_FREQ", "EQ_PEAK_2_GAIN", "EQ_PEAK_2_Q" },
+        { "EQ_PEAK_3_FREQ", "EQ_PEAK_3_GAIN", "EQ_PEAK_3_Q" },
+        { "EQ_HIGH_FREQ",   "EQ_HIGH_GAIN",   nullptr },
+    };
+
+    MasterEq::Settings settings;
+    for (int band = 0; band < MasterEq::numBands; ++band)
+    {
+        settings[band].frequency = tree.getRawParameterValue(bandIds[band][0])->load();
+        settings[band].gain = tree.getRawParameterValue(bandIds[band][1])->load();
+
+        if (bandIds[band][2] != nullptr)
+            settings[band].q = tree.getRawParameterValue(bandIds[band][2])->load();
+    }
+
+    return settings;
+}
+
+/* The host's tempo, or 120 bpm when it doesn't have one */
+double SympleSynthAudioProcessor::getHostTempo()
+{
+    juce::AudioPlayHead::CurrentPositionInfo position;
+    if (auto* playHead = getPlayHead())
+        if (playHead->getCurrentPosition(position) && position.bpm > 0.0)
+            return position.bpm;
+
+    return 120.0;
 }
 
 /* Gets called when the application is closed. */
@@ -133,7 +260,65 @@ void SympleSynthAudioProcessor::releaseResources()
     // When playback stops, you can use this as an opportunity to free up any
     // spare memory, etc.
     keyboardState.reset();
+    voiceRenderPool.release();
+    reverb.release();
+}
 
+/* The tier follows at the next block, the render threads are started here
+   so the audio thread never has to */
+void SympleSynthAudioProcessor::setNonRealtime(bool isNonRealtime) noexcept
+{
+    AudioProcessor::setNonRealtime(isNonRealtime);
+    reverb.setSynchronous(isNonRealtime);
+
+    const juce::ScopedLock sl (getCallbackLock());
+    updateVoiceRenderPool(false);
+}
+
+void SympleSynthAudioProcessor::setOfflineRenderThreads(int numThreads)
+{
+    const juce::ScopedLock sl (getCallbackLock());
+    offlineRenderThreads = numThreads;
+    updateVoiceRenderPool(false);
+}
+
+/*
+ *  Starts or stops the voice render threads to match the realtime mode. The
+ *  pool is sized for the prepared block, so it waits for prepareToPlay.
+ */
+void SympleSynthAudioProcessor::updateVoiceRenderPool(bool forcePrepare)
+{
+    int numWorkers = 0;
+    if (isNonRealtime() && voiceSpec.sampleRate > 0.0)
+        numWorkers = offlineRenderThreads < 0 ? juce::SystemStats::getNumCpus() - 1 : offlineRenderThreads;
+
+    // one voice per thread at most
+    numWorkers = juce::jlimit(0, juce::jmax(0, synth.getNumVoices() - 1), numWorkers);
+
+    if (forcePrepare || numWorkers != voiceRenderPool.getNumWorkers())
+        voiceRenderPool.prepare(numWorkers, (int)voiceSpec.numChannels, (int)voiceSpec.maximumBlockSize);
+
+    synth.setVoiceRenderPool(numWorkers > 0 ? &voiceRenderPool : nullptr);
+
+    // the stage timings aren't thread safe, so they only cover serial renders
+    for (int i = 0; i < synth.getNumVoices(); ++i)
+        dynamic_cast<SynthVoice*>(synth.getVoice(i))->setProfiler(numWorkers > 0 ? nullptr : &profiler);
+}
+
+/* Called when the host jumps or an offline render starts over, stops every voice dead. */
+void SympleSynthAudioProcessor::reset()
+{
+    synth.allNotesOff(0, false);
+    voiceEngine.allNotesOff();
+    keyboardState.reset();
+
+    // no effect may carry its tail or delay line over a transport jump or
+    // into the next render of a batch
+    masterEq.reset();
+    chorus.reset();
+    tempoDelay.reset();
+    reverb.reset();
+    limiter.reset();
 }
 
 #ifndef JucePlugin_PreferredChannelConfigurations
@@ -166,39 +351,197 @@ So 44100 / 512 = 86 times per second
 void SympleSynthAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
     juce::ScopedNoDenormals noDenormals;
+    SYMPLE_REALTIME_SCOPE();
+    SYMPLE_TRACE_SCOPE("processBlock");
     auto totalNumOutputChannels = getTotalNumOutputChannels();
+    SYMPLE_PROFILE_BEGIN_BLOCK(profiler, buffer.getNumSamples(), getSampleRate());
+    blockTimeMonitor.beginBlock(buffer.getNumSamples(), getSampleRate());
+    const int numMidiEvents = midiMessages.getNumEvents();
 
     buffer.clear();
+
+    // program changes are prepared off the audio thread, a pending preset is
+    // picked up here so every voice sees the new parameters for the whole block
+    for (const auto metadata : midiMessages)
+    {
+        const auto message = metadata.getMessage();
+        if (message.isProgramChange())
+            presetBank.requestPreset(message.getProgramChangeNumber());
+    }
+    presetBank.applyPendingPreset();
+
+    // a new tier or rate context takes effect from this block
+    const auto requestedQuality = getRequestedQuality();
+    if (requestedQuality != renderQuality || rateContext.load() != appliedRateContext)
+        applyRenderQuality(requestedQuality);
+
+    // bounces have no deadline, so the governor only runs live
+    const bool governorEnabled = tree.getRawParameterValue("CPU_GOVERNOR")->load() > 0.5f && !isNonRealtime();
+    if (!governorEnabled && governorLevel > 0)
+    {
+        governor.reset();
+        applyGovernorLevel(0);
+    }
+
     keyboardState.processNextMidiBuffer(midiMessages, 0,
         buffer.getNumSamples(), true);
     
-    // prepare lfo for synth processing
-    lfoBuffer.clear();
-    float lfoFrequency = tree.getRawParameterValue("LFO_FREQUENCY")->load();
-    int oscMode = tree.getParameterAsValue("LFO_WAVE_TYPE").getValue();
-    lfo.setMode(static_cast<OscillatorMode> (oscMode));
-    lfo.setFrequency(lfoFrequency);
-    if (lfoFrequency < 0.0005)
+    // silence whichever renderer was playing if the engine was switched
+    const bool engineEnabled = useVoiceEngine.load();
+    if (engineEnabled != voiceEngineWasUsed)
     {
-        lfoBuffer.fill(-1.0f);
+        synth.allNotesOff(0, false);
+        voiceEngine.allNotesOff();
+        voiceEngineWasUsed = engineEnabled;
     }
-    else
+
+    // the lfo and voices always run in sub-blocks of the same size, so their
+    // cost per sample doesn't depend on the host's block size, and a block
+    // larger than the one prepareToPlay announced is fine
+    for (int start = 0; start < buffer.getNumSamples(); start += subBlockSize)
+        renderSubBlock(buffer, midiMessages, start, juce::jmin(subBlockSize, buffer.getNumSamples() - start), engineEnabled);
+
     {
-        lfo.generate(lfoBuffer, buffer.getNumSamples(), 0.0);
+        SYMPLE_PROFILE_STAGE(&profiler, ProfileStage::Eq);
+        masterEq.setParameters(getEqSettings());
+        masterEq.process(buffer, buffer.getNumSamples());
     }
-    
-    // This needs to be before this process loop.
-    synth.renderNextBlock(buffer, midiMessages, 0, buffer.getNumSamples());
-    float gainValue = tree.getRawParameterValue("MASTER_GAIN")->load();
-    for (int channel = 0; channel < totalNumOutputChannels; ++channel)
+
     {
-        auto* channelData = buffer.getWritePointer(channel);
-        for (int sample = 0; sample < buffer.getNumSamples(); ++sample)
+        SYMPLE_PROFILE_STAGE(&profiler, ProfileStage::Effects);
+        chorus.setParameters(tree.getRawParameterValue("CHORUS_RATE")->load(),
+                             tree.getRawParameterValue("CHORUS_DEPTH")->load() / 100.0f,
+                             tree.getRawParameterValue("CHORUS_MIX")->load() / 100.0f);
+        chorus.process(buffer, buffer.getNumSamples());
+
+        const double beats = DelayDivisions::getBeats(tree.getRawParameterValue("DELAY_TIME")->load());
+        hostTempo = getHostTempo();
+        tempoDelay.setParameters((float)(beats * 60.0 / hostTempo.load()),
+                                 tree.getRawParameterValue("DELAY_FEEDBACK")->load() / 100.0f,
+                                 tree.getRawParameterValue("DELAY_MIX")->load() / 100.0f);
+        tempoDelay.process(buffer, buffer.getNumSamples());
+    }
+
+    {
+        SYMPLE_PROFILE_STAGE(&profiler, ProfileStage::MasterGain);
+        float gainValue = tree.getRawParameterValue("MASTER_GAIN")->load();
+        for (int channel = 0; channel < totalNumOutputChannels; ++channel)
         {
-            channelData[sample] = channelData[sample] * juce::Decibels::decibelsToGain(gainValue);
+            auto* channelData = buffer.getWritePointer(channel);
+            for (int sample = 0; sample < buffer.getNumSamples(); ++sample)
+            {
+                channelData[sample] = channelData[sample] * juce::Decibels::decibelsToGain(gainValue);
+            }
         }
     }
+
+    {
+        SYMPLE_PROFILE_STAGE(&profiler, ProfileStage::Reverb);
+        reverb.setRoomSize(tree.getRawParameterValue("REVERB_SIZE")->load());
+        reverb.process(buffer, buffer.getNumSamples(), tree.getRawParameterValue("REVERB_MIX")->load() / 100.0f);
+    }
+
+    {
+        SYMPLE_PROFILE_STAGE(&profiler, ProfileStage::Limiter);
+        limiter.setParameters(tree.getRawParameterValue("LIMITER")->load() > 0.5f,
+                              tree.getRawParameterValue("LIMITER_CEILING")->load());
+        limiter.process(buffer, buffer.getNumSamples());
+    }
     midiMessages.clear();
+
+    const int numActiveVoices = engineEnabled ? voiceEngine.getNumActiveVoices() : getNumActiveSynthVoices();
+    SYMPLE_PROFILE_END_BLOCK(profiler, numActiveVoices);
+
+    BlockTimeMonitor::BlockContext context;
+    context.activeVoices = numActiveVoices;
+    context.midiEvents = numMidiEvents;
+    context.filter1Mode = (int)tree.getRawParameterValue("FILTER_1_MODE")->load();
+    context.filter2Mode = (int)tree.getRawParameterValue("FILTER_2_MODE")->load();
+    context.governorLevel = governorLevel;
+    blockTimeMonitor.endBlock(context);
+
+    // the next block runs with whatever the load of this one called for
+    if (governorEnabled && governor.update(blockTimeMonitor.getLastLoad(), buffer.getNumSamples(), getSampleRate()))
+        applyGovernorLevel(governor.getLevel());
+}
+
+/*
+ *  Renders numSamples of the block from start, with the midi events that
+ *  fall in that range made relative to the sub-block
+ */
+void SympleSynthAudioProcessor::renderSubBlock(juce::AudioBuffer<float>& buffer, const juce::MidiBuffer& midi,
+                                               int start, int numSamples, bool engineEnabled)
+{
+    const int totalNumOutputChannels = getTotalNumOutputChannels();
+    const int end = start + numSamples;
+    const bool lastSubBlock = end == buffer.getNumSamples();
+
+    float* outputChannels[2] = { buffer.getWritePointer(0, start), totalNumOutputChannels > 1 ? buffer.getWritePointer(1, start) : nullptr };
+    subBlockBuffer.setDataToReferTo(outputChannels, totalNumOutputChannels, numSamples);
+
+    // events past the end of the block are played at its last sub-block,
+    // and with the voices oversampled they move to the matching voice sample
+    subBlockMidi.clear();
+    for (auto it = midi.findNextSamplePosition(start); it != midi.cend(); ++it)
+    {
+        const auto metadata = *it;
+        if (metadata.samplePosition >= end && !lastSubBlock)
+            break;
+
+        const int position = juce::jmin(metadata.samplePosition, end - 1) - start;
+        subBlockMidi.addEvent(metadata.data, metadata.numBytes, position * oversamplingFactor);
+    }
+
+    // prepare lfo for synth processing
+    {
+        SYMPLE_PROFILE_STAGE(&profiler, ProfileStage::Lfo);
+        lfoBuffer.clear();
+        float lfoFrequency = tree.getRawParameterValue("LFO_FREQUENCY")->load();
+        int oscMode = juce::roundToInt(tree.getRawParameterValue("LFO_WAVE_TYPE")->load());
+        lfo.setMode(static_cast<OscillatorMode> (oscMode));
+        lfo.setFrequency(lfoFrequency);
+        if (lfoFrequency < 0.0005)
+        {
+            lfoBuffer.fill(-1.0f);
+        }
+        else
+        {
+            lfo.generate(lfoBuffer, numSamples * oversamplingFactor, 0.0);
+        }
+    }
+
+    if (oversamplingFactor > 1)
+    {
+        // render the voices into the oversampler's buffer at the voice rate
+        auto block = oversampling->processSamplesUp(juce::dsp::AudioBlock<float>(subBlockBuffer));
+        block.clear();
+
+        float* channels[2] = { block.getChannelPointer(0), totalNumOutputChannels > 1 ? block.getChannelPointer(1) : nullptr };
+        oversampledBuffer.setDataToReferTo(channels, totalNumOutputChannels, (int)block.getNumSamples());
+
+        renderVoices(oversampledBuffer, subBlockMidi, engineEnabled);
+
+        SYMPLE_PROFILE_STAGE(&profiler, ProfileStage::Oversampling);
+        oversampling->processSamplesDown(juce::dsp::AudioBlock<float>(subBlockBuffer));
+    }
+    else
+    {
+        renderVoices(subBlockBuffer, subBlockMidi, engineEnabled);
+    }
+}
+
+void SympleSynthAudioProcessor::renderVoices(juce::AudioBuffer<float>& voiceBuffer, juce::MidiBuffer& voiceMidi, bool engineEnabled)
+{
+    if (engineEnabled)
+    {
+        SYMPLE_TRACE_SCOPE("voiceEngine.renderNextBlock");
+        voiceEngine.renderNextBlock(voiceBuffer, voiceMidi, lfoBuffer, 0, voiceBuffer.getNumSamples());
+    }
+    else
+    {
+        SYMPLE_TRACE_SCOPE("synth.renderBlock");
+        synth.renderBlock(voiceBuffer, voiceMidi, 0, voiceBuffer.getNumSamples());
+    }
 }
 
 //==============================================================================
@@ -215,15 +558,15 @@ juce::AudioProcessorEditor* SympleSynthAudioProcessor::createEditor()
 //==============================================================================
 void SympleSynthAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
 {
-    // You should use this method to store your parameters in the memory block.
-    // You could do that either as raw data, or use the XML or ValueTree classes
-    // as intermediaries to make it easy to save and load complex data.
+    // parameters are stored as fixed size binary records, see PluginState.h
+    PluginState::write(getParameters(), destData);
 }
 
 void SympleSynthAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
 {
-    // You should use this method to restore your parameters from this memory block,
-    // whose contents will have been created by the getStateInformation() call.
+    // restore straight into the parameters, falling back to the xml format
+    if (!PluginState::read(getParameters(), data, sizeInBytes))
+        PluginState::readXml(tree, data, sizeInBytes);
 }
 
 juce::MidiKeyboardState& SympleSynthAudioProcessor::getKeyboardState()
@@ -231,11 +574,105 @@ juce::MidiKeyboardState& SympleSynthAudioProcessor::getKeyboardState()
     return keyboardState;
 }
 
+void SympleSynthAudioProcessor::setVoiceSilenceThreshold(float decibels)
+{
+    const juce::ScopedLock sl (getCallbackLock());
+    voiceSilenceThreshold = decibels;
+    applyGovernorLevel(governorLevel);
+}
+
+/*
+ *  Applies a CpuGovernor level on top of the configured silence threshold
+ *  and polyphony of both renderers. Called from the audio thread.
+ */
+void SympleSynthAudioProcessor::applyGovernorLevel(int level)
+{
+    governorLevel = level;
+    const auto degradation = CpuGovernor::getDegradation(level);
+    const float threshold = juce::jmax(voiceSilenceThreshold, degradation.silenceThresholdDb);
+
+    synth.setSilenceThreshold(threshold);
+    synth.setControlRateScale(degradation.controlRateScale);
+    synth.setMaxActiveVoices(juce::roundToInt(synth.getNumVoices() * degradation.polyphonyScale));
+
+    voiceEngine.setSilenceThreshold(threshold);
+    voiceEngine.setPolyphony(juce::roundToInt(voiceEnginePolyphony * degradation.polyphonyScale));
+}
+
+void SympleSynthAudioProcessor::setVoiceEngineEnabled(bool shouldUseVoiceEngine)
+{
+    useVoiceEngine = shouldUseVoiceEngine;
+}
+
+void SympleSynthAudioProcessor::setVoiceEnginePolyphony(int numVoices)
+{
+    const juce::ScopedLock sl (getCallbackLock());
+    voiceEnginePolyphony = numVoices;
+    applyGovernorLevel(governorLevel);
+}
+
+void SympleSynthAudioProcessor::setMaximumSimdLevel(SimdLevel level)
+{
+    voiceEngine.setMaximumSimdLevel(level);
+}
+
+/* Rebuilds the synth with a new number of voices, used by the benchmarks to
+   measure polyphony. Notes that are playing are cut. */
+void SympleSynthAudioProcessor::setNumVoices(int numVoices)
+{
+    const juce::ScopedLock sl (getCallbackLock());
+
+    synth.clearVoices();
+    for (int i = 0; i < numVoices; ++i)
+        synth.addVoice(new SynthVoice(tree, lfoBuffer, synth.getCurrentEventSample()));
+
+    synth.setProfiler(&profiler);
+    applyGovernorLevel(governorLevel);
+    updateVoiceRenderPool(false);
+
+    if (voiceSpec.sampleRate > 0.0)
+        prepareVoices(voiceSpec);
+}
+
+int SympleSynthAudioProcessor::getNumVoices() const
+{
+    return synth.getNumVoices();
+}
+
+/* Starts or stops writing a Chrome trace of the audio thread to the user's
+   application data folder. The trace is shared by every instance of the plugin */
+void SympleSynthAudioProcessor::setTracingEnabled(bool shouldTrace)
+{
+    if (shouldTrace && !traceRecorder->isRecording())
+        traceRecorder->start(TraceRecorder::getDefaultTraceFile());
+    else if (!shouldTrace)
+        traceRecorder->stop();
+}
+
+int SympleSynthAudioProcessor::getNumActiveSynthVoices() const
+{
+    int numActive = 0;
+    for (int i = 0; i < synth.getNumVoices(); ++i)
+    {
+        if (synth.getVoice(i)->isVoiceActive())
+            ++numActive;
+    }
+    return numActive;
+}
+
 void SympleSynthAudioProcessor::prepareVoices(juce::dsp::ProcessSpec& spec)
 {
+    if (rateContext.load() == nullptr || rateContext.load()->hostRate != spec.sampleRate)
+        rateContext.store(rateContexts->getContext(spec.sampleRate));
+
+    const auto settings = RenderQualityTiers::getSettings(renderQuality);
+    const auto& rates = rateContext.load()->getVoiceRates(renderQuality);
+
     for (int i = 0; i < synth.getNumVoices(); ++i)
     {
-        dynamic_cast<SynthVoice*>(synth.getVoice(i))->prepare(spec);
+        auto* voice = dynamic_cast<SynthVoice*>(synth.getVoice(i));
+        voice->prepare(spec);
+        voice->setRenderQuality(settings, rates);
     }
 }
 
@@ -332,6 +769,87 @@ juce::AudioProcessorValueTreeState::ParameterLayout SympleSynthAudioProcessor::c
     parameters.push_back(std::make_unique<juce::AudioParameterFloat>("LFO_AMOUNT", "LFO Amount", envelopeAmountRange, 0));
     parameters.push_back(std::make_unique<juce::AudioParameterFloat>("LFO_WAVE_TYPE", "LFO Wave Type", oscillatorWaveType, 1));
 
+    // render quality tier, see RenderQuality.h
+    juce::NormalisableRange<float> qualityRange (0, 2, 1);
+    parameters.push_back(std::make_unique<juce::AudioParameterFloat>("QUALITY",
+                                                                     "Quality",
+                                                                     qualityRange,
+                                                                     (float)RenderQuality::Normal,
+                                                                     juce::String(),
+                                                                     juce::AudioProcessorParameter::genericParameter,
+                                                                     [](float value, int) { return juce::String (RenderQualityTiers::getName(RenderQualityTiers::fromParameter(value))); }));
+
+    // lets the CpuGovernor trade quality for time when blocks get close to their deadline
+    juce::NormalisableRange<float> switchRange (0, 1, 1);
+    parameters.push_back(std::make_unique<juce::AudioParameterFloat>("CPU_GOVERNOR",
+                                                                     "CPU Governor",
+                                                                     switchRange,
+                                                                     0.0f,
+                                                                     juce::String(),
+                                                                     juce::AudioProcessorParameter::genericParameter,
+                                                                     [](float value, int) { return juce::String (value > 0.5f ? "On" : "Off"); }));
+
+    // convolution reverb on the master bus, see ConvolutionReverb.h
+    juce::NormalisableRange<float> reverbMixRange (0.0f, 100.0f);
+    juce::NormalisableRange<float> reverbSizeRange (0.3f, 8.0f);
+    reverbSizeRange.setSkewForCentre(2.0f);
+    parameters.push_back(std::make_unique<juce::AudioParameterFloat>("REVERB_MIX", "Reverb Mix", reverbMixRange, 0.0f));
+    parameters.push_back(std::make_unique<juce::AudioParameterFloat>("REVERB_SIZE", "Reverb Size", reverbSizeRange, 2.5f));
+
+    // chorus and tempo delay on the voice mix, see Chorus.h and TempoDelay.h
+    juce::NormalisableRange<float> effectPercentRange (0.0f, 100.0f);
+    juce::NormalisableRange<float> chorusRateRange (0.05f, 5.0f);
+    chorusRateRange.setSkewForCentre(0.8f);
+    parameters.push_back(std::make_unique<juce::AudioParameterFloat>("CHORUS_MIX", "Chorus Mix", effectPercentRange, 0.0f));
+    parameters.push_back(std::make_unique<juce::AudioParameterFloat>("CHORUS_RATE", "Chorus Rate", chorusRateRange, 0.6f));
+    parameters.push_back(std::make_unique<juce::AudioParameterFloat>("CHORUS_DEPTH", "Chorus Depth", effectPercentRange, 50.0f));
+
+    juce::NormalisableRange<float> delayTimeRange (0, DelayDivisions::numDivisions - 1, 1);
+    juce::NormalisableRange<float> delayFeedbackRange (0.0f, 90.0f);
+    parameters.push_back(std::make_unique<juce::AudioParameterFloat>("DELAY_MIX", "Delay Mix", effectPercentRange, 0.0f));
+    parameters.push_back(std::make_unique<juce::AudioParameterFloat>("DELAY_TIME",
+                                                                     "Delay Time",
+                                                                     delayTimeRange,
+                                                                     (float)DelayDivisions::defaultDivision,
+                                                                     juce::String(),
+                                                                     juce::AudioProcessorParameter::genericParameter,
+                                                                     [](float value, int) { return juce::String (DelayDivisions::getName(value)); }));
+    parameters.push_back(std::make_unique<juce::AudioParameterFloat>("DELAY_FEEDBACK", "Delay Feedback", delayFeedbackRange, 35.0f));
+
+    // keeps the output under a true peak ceiling, see OutputLimiter.h
+    juce::NormalisableRange<float> ceilingRange (-12.0f, 0.0f);
+    parameters.push_back(std::make_unique<juce::AudioParameterFloat>("LIMITER",
+                                                                     "Limiter",
+                                                                     switchRange,
+                                                                     1.0f,
+                                                                     juce::String(),
+                                                                     juce::AudioProcessorParameter::genericParameter,
+                                                                     [](float value, int) { return juce::String (value > 0.5f ? "On" : "Off"); }));
+    parameters.push_back(std::make_unique<juce::AudioParameterFloat>("LIMITER_CEILING", "Limiter Ceiling", ceilingRange, -1.0f, "dBTP"));
+
+    // master EQ on the voice mix, see MasterEq.h
+    juce::NormalisableRange<float> eqFrequencyRange (20.0f, 20000.0f);
+    eqFrequencyRange.setSkewForCentre(1000.0f);
+    juce::NormalisableRange<float> eqGainRange (-12.0f, 12.0f);
+    juce::NormalisableRange<float> eqQRange (0.3f, 6.0f);
+    eqQRange.setSkewForCentre(1.0f);
+
+    parameters.push_back(std::make_unique<juce::AudioParameterFloat>("EQ_LOW_FREQ", "EQ Low Freq", eqFrequencyRange, 120.0f, "Hz"));
+    parameters.push_back(std::make_unique<juce::AudioParameterFloat>("EQ_LOW_GAIN", "EQ Low Gain", eqGainRange, 0.0f, "dB"));
+
+    const float peakFrequencies[] = { 400.0f, 1500.0f, 5000.0f };
+    for (int peak = 1; peak <= 3; ++peak)
+    {
+        const juce::String id ("EQ_PEAK_" + juce::String (peak));
+        const juce::String name ("EQ Peak " + juce::String (peak));
+        parameters.push_back(std::make_unique<juce::AudioParameterFloat>(id + "_FREQ", name + " Freq", eqFrequencyRange, peakFrequencies[peak - 1], "Hz"));
+        parameters.push_back(std::make_unique<juce::AudioParameterFloat>(id + "_GAIN", name + " Gain", eqGainRange, 0.0f, "dB"));
+        parameters.push_back(std::make_unique<juce::AudioParameterFloat>(id + "_Q", name + " Q", eqQRange, 0.7f, "Q"));
+    }
+
+    parameters.push_back(std::make_unique<juce::AudioParameterFloat>("EQ_HIGH_FREQ", "EQ High Freq", eqFrequencyRange, 8000.0f, "Hz"));
+    parameters.push_back(std::make_unique<juce::AudioParameterFloat>("EQ_HIGH_GAIN", "EQ High Gain", eqGainRange, 0.0f, "dB"));
+
     return { parameters.begin(), parameters.end() };
 }
 
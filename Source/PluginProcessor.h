@@ -10,6 +10,20 @@
 
 #include <JuceHeader.h>
 #include "Voice.h"
+#include "SympleSynthesiser.h"
+#include "VoiceEngine.h"
+#include "PresetBank.h"
+#include "BlockTimeMonitor.h"
+#include "RealtimeChecks.h"
+#include "RenderQuality.h"
+#include "CpuGovernor.h"
+#include "RateContext.h"
+#include "TraceRecorder.h"
+#include "ConvolutionReverb.h"
+#include "MasterEq.h"
+#include "Chorus.h"
+#include "TempoDelay.h"
+#include "OutputLimiter.h"
 
 //==============================================================================
 /**
@@ -24,6 +38,11 @@ public:
     //==============================================================================
     void prepareToPlay(double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
+    void reset() override;
+
+    /* Bounces switch to the Offline quality tier and render the voices on
+       every core, see RenderQuality.h and VoiceRenderPool.h */
+    void setNonRealtime(bool isNonRealtime) noexcept override;
 
 #ifndef JucePlugin_PreferredChannelConfigurations
     bool isBusesLayoutSupported(const BusesLayout& layouts) const override;
@@ -57,6 +76,38 @@ public:
     juce::MidiKeyboardState& getKeyboardState();
     void prepareVoices(juce::dsp::ProcessSpec&);
     juce::AudioProcessorValueTreeState& getTree() { return tree; }
+    void setVoiceSilenceThreshold(float decibels);
+    void setNumVoices(int numVoices);
+    int getNumVoices() const;
+    int getNumActiveSynthVoices() const;
+
+    /* Per stage timings of the audio thread, filled when built with SYMPLE_PROFILING */
+    Profiler& getProfiler() { return profiler; }
+
+    /* Deadline histogram and over budget log, dumped to json in the background */
+    BlockTimeMonitor& getBlockTimeMonitor() { return blockTimeMonitor; }
+    void setTracingEnabled(bool shouldTrace);
+
+    /* Switches between the juce::Synthesiser voices and the structure-of-arrays
+       VoiceEngine, which can run many more voices per core */
+    void setVoiceEngineEnabled(bool shouldUseVoiceEngine);
+    void setVoiceEnginePolyphony(int numVoices);
+
+    /* Caps the VoiceEngine instruction set, applied at the next prepareToPlay */
+    void setMaximumSimdLevel(SimdLevel level);
+
+    /* The tier the voices are running at, follows the QUALITY parameter */
+    RenderQuality getRenderQuality() const { return renderQuality; }
+
+    /* How far the CPU governor has stepped down, 0 when it is off or idle */
+    int getGovernorLevel() const { return governorLevel; }
+
+    /* The master bus reverb, e.g. to load an impulse response file */
+    ConvolutionReverb& getReverb() { return reverb; }
+
+    /* Worker threads for non-realtime renders, on top of the calling thread.
+       -1 uses one per core, 0 renders on the calling thread only */
+    void setOfflineRenderThreads(int numThreads);
     std::vector<std::unique_ptr<juce::RangedAudioParameter>> parameters;
     
     Oscillator lfo;
@@ -64,13 +115,84 @@ public:
 
 private:
     const int VOICE_COUNT = 5;
-    
-    juce::Synthesiser synth;
+    const float VOICE_SILENCE_THRESHOLD = -100.0f; // released voices below this level (dB) are freed
+
+    Profiler profiler;
+    juce::SharedResourcePointer<TraceRecorder> traceRecorder;  // so the first trace marker doesn't build it
+    SympleSynthesiser synth;
+    juce::dsp::ProcessSpec voiceSpec {};
+    float voiceSilenceThreshold = VOICE_SILENCE_THRESHOLD;
     juce::MidiKeyboardState keyboardState;
 
     juce::AudioProcessorValueTreeState tree;
     juce::AudioProcessorValueTreeState::ParameterLayout createParameters();
 
+    VoiceEngine voiceEngine;
+    std::atomic<bool> useVoiceEngine { false };
+    bool voiceEngineWasUsed = false;
+
+    PresetBank presetBank;
+    BlockTimeMonitor blockTimeMonitor;
+
+    // quality tier, everything High needs is allocated in prepareToPlay so
+    // the tier can be switched between blocks
+    RenderQuality renderQuality = RenderQuality::Normal;
+    int oversamplingFactor = 1;
+    double appliedVoiceRate = 0.0;  // the voice engine and oversampler were last reset for this rate
+    std::unique_ptr<juce::dsp::Oversampling<float>> oversampling;
+    juce::AudioBuffer<float> oversampledBuffer;
+
+    RenderQuality getRequestedQuality();
+    void applyRenderQuality(RenderQuality);
+
+    // everything derived from the host rate, built off the audio thread and
+    // published here by prepareToPlay, see RateContext.h
+    juce::SharedResourcePointer<RateContextBuilder> rateContexts;
+    std::atomic<const RateContext*> rateContext { nullptr };
+    const RateContext* appliedRateContext = nullptr; // what the voices were last set up with
+
+    // steps the voices down when blocks get close to their deadline, switched
+    // on with the CPU_GOVERNOR parameter
+    CpuGovernor governor;
+    int governorLevel = 0;
+    int voiceEnginePolyphony;
+
+    void applyGovernorLevel(int level);
+
+    // after master gain, set with REVERB_MIX and REVERB_SIZE
+    ConvolutionReverb reverb;
+
+    // first on the voice mix, set with the EQ_ parameters
+    MasterEq masterEq;
+    MasterEq::Settings getEqSettings();
+
+    // on the voice mix before master gain, set with the CHORUS_ and DELAY_
+    // parameters. The delay follows the host tempo
+    Chorus chorus;
+    TempoDelay tempoDelay;
+
+    double getHostTempo();
+    std::atomic<double> hostTempo { 120.0 };    // of the last block, for getTailLengthSeconds
+
+    // the end of the chain, set with LIMITER and LIMITER_CEILING. Its
+    // latency is reported whether it is on or not
+    OutputLimiter limiter;
+
+    // voices of non-realtime renders are spread over these threads
+    VoiceRenderPool voiceRenderPool;
+    int offlineRenderThreads = -1;
+
+    void updateVoiceRenderPool(bool forcePrepare);
+
+    // host blocks are rendered in sub-blocks of this many samples, small
+    // enough for the voice state and buffers to stay in L1
+    static constexpr int subBlockSize = 64;
+    juce::AudioBuffer<float> subBlockBuffer;    // refers to part of the host block
+    juce::MidiBuffer subBlockMidi;
+
+    void renderSubBlock(juce::AudioBuffer<float>&, const juce::MidiBuffer&, int start, int numSamples, bool engineEnabled);
+    void renderVoices(juce::AudioBuffer<float>&, juce::MidiBuffer&, bool engineEnabled);
+
     float lastSampleRate;
     juce::HeapBlock<char> heapBlock;
     //==============================================================================
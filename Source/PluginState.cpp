@@ -0,0 +1,101 @@
+/*
+  ==============================================================================
+
+    PluginState.cpp
+    Created: 19 Oct 2026
+    Author:  woz
+
+  ==============================================================================
+*/
+
+#include "PluginState.h"
+
+namespace PluginState
+{
+    constexpr int headerSize = 12;
+    constexpr int recordSize = 8;
+
+    void write(const juce::Array<juce::AudioProcessorParameter*>& parameters, juce::MemoryBlock& destData)
+    {
+        destData.setSize((size_t)(headerSize + parameters.size() * recordSize));
+        juce::MemoryOutputStream stream(destData, false);
+
+        stream.writeInt((int)magic);
+        stream.writeShort((short)version);
+        stream.writeShort((short)recordSize);
+        stream.writeInt(parameters.size());
+
+        for (int index = 0; index < parameters.size(); ++index)
+        {
+            stream.writeShort((short)index);
+            stream.writeShort(0);
+            stream.writeFloat(parameters.getUnchecked(index)->getValue());
+        }
+    }
+
+    bool read(const juce::Array<juce::AudioProcessorParameter*>& parameters, const void* data, int sizeInBytes)
+    {
+        if (data == nullptr || sizeInBytes < headerSize)
+            return false;
+
+        auto* bytes = static_cast<const char*>(data);
+
+        if (juce::ByteOrder::littleEndianInt(bytes) != magic)
+            return false;
+
+        const int storedRecordSize = juce::ByteOrder::littleEndianShort(bytes + 6);
+        const auto numRecords = (int)juce::ByteOrder::littleEndianInt(bytes + 8);
+
+        if (storedRecordSize < recordSize || numRecords < 0
+            || (juce::int64)headerSize + (juce::int64)numRecords * storedRecordSize > (juce::int64)sizeInBytes)
+            return false;
+
+        // anything the blob does not mention goes back to its default
+        juce::HeapBlock<bool> restored((size_t)parameters.size(), true);
+        auto* record = bytes + headerSize;
+
+        for (int i = 0; i < numRecords; ++i, record += storedRecordSize)
+        {
+            const int index = juce::ByteOrder::littleEndianShort(record);
+
+            if (!juce::isPositiveAndBelow(index, parameters.size()))
+                continue;
+
+            const auto rawValue = juce::ByteOrder::littleEndianInt(record + 4);
+            float value;
+            std::memcpy(&value, &rawValue, sizeof(value));
+
+            parameters.getUnchecked(index)->setValueNotifyingHost(juce::jlimit(0.0f, 1.0f, value));
+            restored[index] = true;
+        }
+
+        for (int index = 0; index < parameters.size(); ++index)
+        {
+            if (!restored[index])
+            {
+                auto* parameter = parameters.getUnchecked(index);
+                parameter->setValueNotifyingHost(parameter->getDefaultValue());
+            }
+        }
+
+        return true;
+    }
+
+    void writeXml(juce::AudioProcessorValueTreeState& tree, juce::MemoryBlock& destData)
+    {
+        auto state = tree.copyState();
+        std::unique_ptr<juce::XmlElement> xml(state.createXml());
+        juce::AudioProcessor::copyXmlToBinary(*xml, destData);
+    }
+
+    bool readXml(juce::AudioProcessorValueTreeState& tree, const void* data, int sizeInBytes)
+    {
+        std::unique_ptr<juce::XmlElement> xml(juce::AudioProcessor::getXmlFromBinary(data, sizeInBytes));
+
+        if (xml == nullptr || !xml->hasTagName(tree.state.getType()))
+            return false;
+
+        tree.replaceState(juce::ValueTree::fromXml(*xml));
+        return true;
+    }
+}
@@ -0,0 +1,45 @@
+/*
+  ==============================================================================
+
+    PluginState.h
+    Created: 19 Oct 2026
+    Author:  woz
+    Notes: Compact binary format for the plugin parameters.
+
+           header   uint32  magic 'SYMS'
+                    uint16  format version
+                    uint16  size of one record in bytes
+                    uint32  number of records
+           records  uint16  parameter index
+                    uint16  reserved, 0
+                    float32 normalised value
+
+           Everything is little endian. Parameters are keyed by their index,
+           so new parameters must always be added to the end of the layout.
+           Parameters missing from a blob are set to their defaults, records
+           for unknown indices are skipped, and a newer version may grow the
+           record as long as the first 8 bytes keep this layout.
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+namespace PluginState
+{
+    constexpr juce::uint32 magic = 0x53594d53; // "SYMS" read as little endian
+    constexpr juce::uint16 version = 1;
+
+    /* Writes the current value of every parameter into destData */
+    void write(const juce::Array<juce::AudioProcessorParameter*>& parameters, juce::MemoryBlock& destData);
+
+    /* Restores parameters from a blob written by write(). Returns false and
+       leaves the parameters untouched if the data is not in this format */
+    bool read(const juce::Array<juce::AudioProcessorParameter*>& parameters, const void* data, int sizeInBytes);
+
+    /* The ValueTree to XML route, kept for loading older sessions and for
+       comparing against the binary format */
+    void writeXml(juce::AudioProcessorValueTreeState& tree, juce::MemoryBlock& destData);
+    bool readXml(juce::AudioProcessorValueTreeState& tree, const void* data, int sizeInBytes);
+}
@@ -0,0 +1,300 @@
+/*
+  ==============================================================================
+
+    PresetBank.cpp
+    Created: 19 Oct 2026
+    Author:  woz
+
+  ==============================================================================
+*/
+
+#include "PresetBank.h"
+
+namespace
+{
+    constexpr juce::uint32 bankMagic = 0x424d5953; // "SYMB" read as little endian
+    constexpr juce::uint16 bankVersion = 1;
+}
+
+PresetBank::PresetBank(juce::AudioProcessorValueTreeState& tree)
+    : juce::Thread("SympleSynth preset loader"), parameters(tree.processor.getParameters()),
+      unsentChanges((size_t)parameters.size())
+{
+    for (auto* parameter : parameters)
+    {
+        auto* ranged = dynamic_cast<juce::RangedAudioParameter*>(parameter);
+        rangedParameters.add(ranged);
+        rawValues.add(ranged != nullptr ? tree.getRawParameterValue(ranged->paramID) : nullptr);
+    }
+
+    for (auto& snapshot : snapshots)
+        snapshot.values.calloc((size_t)juce::jmax(1, parameters.size()));
+}
+
+PresetBank::~PresetBank()
+{
+    cancelPendingUpdate();
+    stopLoader();
+}
+
+bool PresetBank::open(const juce::File& bankFile)
+{
+    close();
+
+    auto file = std::make_unique<juce::MemoryMappedFile>(bankFile, juce::MemoryMappedFile::readOnly);
+    auto* data = static_cast<const char*>(file->getData());
+    const auto size = (juce::int64)file->getSize();
+
+    if (data == nullptr || size < headerSize || juce::ByteOrder::littleEndianInt(data) != bankMagic)
+        return false;
+
+    const int numParams = juce::ByteOrder::littleEndianShort(data + 6);
+    const int count = (int)juce::ByteOrder::littleEndianInt(data + 8);
+
+    if (count <= 0 || headerSize + (juce::int64)count * (indexEntrySize + numParams * 4) > size)
+        return false;
+
+    mappedFile = std::move(file);
+    bankParameters = numParams;
+    numPresets = count;
+
+    // index the names and categories up front, the audio thread never needs them
+    for (int i = 0; i < numPresets; ++i)
+    {
+        auto* entry = data + headerSize + i * indexEntrySize;
+        auto name = readFixedString(entry, nameLength);
+        auto category = readFixedString(entry + nameLength, categoryLength);
+
+        names.add(name);
+        nameIndex.set(name, i);
+        presetCategory.add(categories.addIfNotAlreadyThere(category) ? categories.size() - 1
+                                                                     : categories.indexOf(category));
+    }
+
+    startThread();
+    return true;
+}
+
+void PresetBank::close()
+{
+    stopLoader();
+
+    mappedFile.reset();
+    numPresets = 0;
+    bankParameters = 0;
+    names.clear();
+    nameIndex.clear();
+    categories.clear();
+    presetCategory.clear();
+    snapshotState = initialSnapshotState;
+    requestedPreset = -1;
+}
+
+void PresetBank::stopLoader()
+{
+    // the loader sleeps until it is asked for something
+    signalThreadShouldExit();
+    notify();
+    stopThread(1000);
+}
+
+juce::String PresetBank::getName(int index) const
+{
+    return names[index];
+}
+
+juce::String PresetBank::getCategory(int index) const
+{
+    return categories[presetCategory[index]];
+}
+
+int PresetBank::findPreset(const juce::String& name) const
+{
+    return nameIndex.contains(name) ? nameIndex[name] : -1;
+}
+
+juce::Array<int> PresetBank::getPresetsInCategory(const juce::String& category) const
+{
+    juce::Array<int> result;
+    const int categoryIndex = categories.indexOf(category);
+
+    for (int i = 0; i < numPresets; ++i)
+        if (presetCategory.getUnchecked(i) == categoryIndex)
+            result.add(i);
+
+    return result;
+}
+
+void PresetBank::requestPreset(int index)
+{
+    if (!juce::isPositiveAndBelow(index, numPresets))
+        return;
+
+    currentPreset = index;
+    requestedPreset = index;
+    notify();
+}
+
+bool PresetBank::applyPendingPreset()
+{
+    // swap the reading slot for the ready one if that holds a new preset
+    int state = snapshotState.load();
+    int newState;
+
+    do
+    {
+        if ((state & freshFlag) == 0)
+            return false;
+
+        newState = (state & (slotMask << writingShift))
+                 | (getSlot(state, readyShift) << readingShift)
+                 | (getSlot(state, readingShift) << readyShift);
+    }
+    while (!snapshotState.compare_exchange_weak(state, newState));
+
+    auto& snapshot = snapshots[getSlot(newState, readingShift)];
+    bool changed = false;
+
+    for (int index = 0; index < parameters.size(); ++index)
+    {
+        auto* parameter = parameters.getUnchecked(index);
+        const float value = snapshot.values[index];
+
+        if (parameter->getValue() == value)
+            continue;
+
+        // setValue doesn't call any listeners, so the tree's raw value is
+        // written here as well
+        parameter->setValue(value);
+        if (auto* raw = rawValues.getUnchecked(index))
+            raw->store(rangedParameters.getUnchecked(index)->convertFrom0to1(value));
+
+        unsentChanges[(size_t)index] = true;
+        changed = true;
+    }
+
+    if (changed)
+        triggerAsyncUpdate();
+
+    return true;
+}
+
+/* Tells the host and the parameter listeners about the values the audio
+   thread applied */
+void PresetBank::handleAsyncUpdate()
+{
+    for (int index = 0; index < parameters.size(); ++index)
+    {
+        if (unsentChanges[(size_t)index].exchange(false))
+        {
+            auto* parameter = parameters.getUnchecked(index);
+            parameter->setValueNotifyingHost(parameter->getValue());
+        }
+    }
+}
+
+/*
+ *  Waits for requests and copies the preset out of the mapped file. Any page
+ *  faults on the bank happen here instead of on the audio thread.
+ */
+void PresetBank::run()
+{
+    while (!threadShouldExit())
+    {
+        const int preset = requestedPreset.exchange(-1);
+
+        if (preset >= 0)
+            prepareSnapshot(preset);
+        else
+            wait(-1);
+    }
+}
+
+void PresetBank::prepareSnapshot(int preset)
+{
+    // only this thread moves the writing slot, the audio thread never sees it
+    const int slot = getSlot(snapshotState.load(), writingShift);
+    auto& snapshot = snapshots[slot];
+    auto* values = getPresetData(preset);
+
+    for (int index = 0; index < parameters.size(); ++index)
+    {
+        if (index < bankParameters)
+        {
+            const auto rawValue = juce::ByteOrder::littleEndianInt(values + index * 4);
+            float value;
+            std::memcpy(&value, &rawValue, sizeof(value));
+            snapshot.values[index] = juce::jlimit(0.0f, 1.0f, value);
+        }
+        else
+        {
+            // presets from an older layout leave newer parameters at their defaults
+            snapshot.values[index] = parameters.getUnchecked(index)->getDefaultValue();
+        }
+    }
+
+    snapshot.preset = preset;
+
+    // publish it as the ready slot and take the old ready slot to write next
+    int state = snapshotState.load();
+    int newState;
+
+    do
+    {
+        newState = (state & (slotMask << readingShift))
+                 | (slot << readyShift)
+                 | (getSlot(state, readyShift) << writingShift)
+                 | freshFlag;
+    }
+    while (!snapshotState.compare_exchange_weak(state, newState));
+}
+
+const char* PresetBank::getPresetData(int index) const
+{
+    auto* data = static_cast<const char*>(mappedFile->getData());
+    return data + headerSize + numPresets * indexEntrySize + index * bankParameters * 4;
+}
+
+juce::String PresetBank::readFixedString(const char* data, int maxLength)
+{
+    int length = 0;
+    while (length < maxLength && data[length] != 0)
+        ++length;
+
+    return juce::String::fromUTF8(data, length);
+}
+
+bool PresetBank::writeBank(const juce::File& bankFile, int numParameters, const juce::Array<Preset>& presets)
+{
+    bankFile.deleteFile();
+    juce::FileOutputStream stream(bankFile);
+
+    if (!stream.openedOk())
+        return false;
+
+    stream.writeInt((int)bankMagic);
+    stream.writeShort((short)bankVersion);
+    stream.writeShort((short)numParameters);
+    stream.writeInt(presets.size());
+
+    for (auto& preset : presets)
+    {
+        char entry[indexEntrySize] = {};
+        preset.name.copyToUTF8(entry, nameLength);
+        preset.category.copyToUTF8(entry + nameLength, categoryLength);
+        stream.write(entry, indexEntrySize);
+    }
+
+    for (auto& preset : presets)
+        for (int index = 0; index < numParameters; ++index)
+            stream.writeFloat(index < (int)preset.values.size() ? preset.values[(size_t)index] : 0.0f);
+
+    return stream.getStatus().wasOk();
+}
+
+juce::File PresetBank::getDefaultBankFile()
+{
+    return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+        .getChildFile("SympleSynth")
+        .getChildFile("SympleSynth.presets");
+}
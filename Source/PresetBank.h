@@ -0,0 +1,130 @@
+/*
+  ==============================================================================
+
+    PresetBank.h
+    Created: 19 Oct 2026
+    Author:  woz
+    Notes: A memory mapped bank of presets with instant program switching.
+
+           header   uint32  magic 'SYMB'
+                    uint16  format version
+                    uint16  number of parameters per preset
+                    uint32  number of presets
+           index    numPresets x (char[32] name, char[16] category), utf8, 0 padded
+           values   numPresets x numParameters float32 normalised values
+
+           Everything is little endian and parameters are keyed by index, the
+           same way as PluginState. The bank is only read by a background
+           thread, which copies the requested preset into one of three
+           preallocated snapshots. The audio thread picks the newest snapshot
+           up at the start of a block, so a program change never allocates or
+           touches the file on the audio thread.
+
+           The snapshots are a triple buffer: the ready, reading and writing
+           slots live in one atomic and each side swaps its slot with the
+           ready one in a single exchange, so neither can get hold of a slot
+           the other is using. The audio thread writes a preset's values
+           straight into the parameters and leaves telling the host about
+           them to the message thread.
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+class PresetBank : private juce::Thread,
+                   private juce::AsyncUpdater
+{
+public:
+    static constexpr int nameLength = 32;
+    static constexpr int categoryLength = 16;
+
+    struct Preset
+    {
+        juce::String name;
+        juce::String category;
+        std::vector<float> values; // normalised, by parameter index
+    };
+
+    explicit PresetBank(juce::AudioProcessorValueTreeState& tree);
+    ~PresetBank() override;
+
+    /* Maps a bank file and builds the name and category index. Message thread only */
+    bool open(const juce::File& bankFile);
+    void close();
+
+    int getNumPresets() const { return numPresets; }
+    juce::String getName(int index) const;
+    juce::String getCategory(int index) const;
+    int findPreset(const juce::String& name) const;
+    juce::Array<int> getPresetsInCategory(const juce::String& category) const;
+    const juce::StringArray& getCategories() const { return categories; }
+
+    /* Asks the background thread to prepare a preset. Safe to call from any thread */
+    void requestPreset(int index);
+
+    /* Index of the last preset applied, or of the pending one if it is on its way */
+    int getCurrentPreset() const { return currentPreset.load(); }
+
+    /* Applies the newest prepared preset, if there is one. Call from the audio
+       thread at the start of a block. The host hears about the new values
+       later, from the message thread. Returns true if parameters changed */
+    bool applyPendingPreset();
+
+    /* Writes a bank file, used by tools that build banks */
+    static bool writeBank(const juce::File& bankFile, int numParameters, const juce::Array<Preset>& presets);
+
+    /* The default location of the user's bank */
+    static juce::File getDefaultBankFile();
+
+private:
+    static constexpr int headerSize = 12;
+    static constexpr int indexEntrySize = nameLength + categoryLength;
+    static constexpr int numSnapshots = 3;
+
+    // snapshotState packs the ready, reading and writing slots, two bits
+    // each, and a flag set while the ready slot holds a preset not applied yet
+    static constexpr int slotMask = 3;
+    static constexpr int readyShift = 0;
+    static constexpr int readingShift = 2;
+    static constexpr int writingShift = 4;
+    static constexpr int freshFlag = 1 << 6;
+    static constexpr int initialSnapshotState = (0 << readyShift) | (1 << readingShift) | (2 << writingShift);
+
+    struct Snapshot
+    {
+        juce::HeapBlock<float> values;
+        int preset = -1;
+    };
+
+    const juce::Array<juce::AudioProcessorParameter*>& parameters;
+    juce::Array<juce::RangedAudioParameter*> rangedParameters;
+    juce::Array<std::atomic<float>*> rawValues;     // the tree's, by parameter index
+    std::vector<std::atomic<bool>> unsentChanges;   // applied but not sent to the host yet
+    std::unique_ptr<juce::MemoryMappedFile> mappedFile;
+    int numPresets = 0;
+    int bankParameters = 0;
+
+    juce::StringArray names;
+    juce::HashMap<juce::String, int> nameIndex;
+    juce::StringArray categories;
+    juce::Array<int> presetCategory;
+
+    // hand over from the background thread to the audio thread
+    Snapshot snapshots[numSnapshots];
+    std::atomic<int> requestedPreset { -1 };
+    std::atomic<int> currentPreset { 0 };
+    std::atomic<int> snapshotState { initialSnapshotState };
+
+    static int getSlot(int state, int shift) { return (state >> shift) & slotMask; }
+
+    void run() override;
+    void handleAsyncUpdate() override;
+    void stopLoader();
+    void prepareSnapshot(int preset);
+    const char* getPresetData(int index) const;
+    static juce::String readFixedString(const char* data, int maxLength);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PresetBank)
+};
@@ -0,0 +1,71 @@
+/*
+  ==============================================================================
+
+    Profiler.cpp
+    Created: 19 Oct 2026
+    Author:  woz
+
+  ==============================================================================
+*/
+
+#include "Profiler.h"
+
+const char* Profiler::getStageName(ProfileStage stage) noexcept
+{
+    switch (stage)
+    {
+    case ProfileStage::Lfo:          return "LFO";
+    case ProfileStage::Oscillators:  return "Oscillators";
+    case ProfileStage::Noise:        return "Noise";
+    case ProfileStage::Envelopes:    return "Envelopes";
+    case ProfileStage::Filters:      return "Filters";
+    case ProfileStage::VoiceKernel:  return "Voice kernel";
+    case ProfileStage::Oversampling: return "Oversampling";
+    case ProfileStage::Eq:           return "EQ";
+    case ProfileStage::Effects:      return "Chorus and delay";
+    case ProfileStage::MasterGain:   return "Master gain";
+    case ProfileStage::Reverb:       return "Reverb";
+    case ProfileStage::Limiter:      return "Limiter";
+    case ProfileStage::NumStages:    break;
+    }
+
+    return "";
+}
+
+void Profiler::beginBlock(int numSamples, double sampleRate) noexcept
+{
+    current = ProfileFrame();
+    current.numSamples = numSamples;
+    deadlineSeconds = sampleRate > 0.0 ? numSamples / sampleRate : 0.0;
+    blockStartTicks = juce::Time::getHighResolutionTicks();
+    blockStartCycles = readCycleCounter();
+}
+
+void Profiler::endBlock(int activeVoices) noexcept
+{
+    const double seconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - blockStartTicks);
+
+    current.blockCycles = readCycleCounter() - blockStartCycles;
+    current.activeVoices = activeVoices;
+    current.deadlineUsed = deadlineSeconds > 0.0 ? (float)(seconds / deadlineSeconds) : 0.0f;
+
+    int start1, size1, start2, size2;
+    fifo.prepareToWrite(1, start1, size1, start2, size2);
+
+    if (size1 > 0)
+        frames[(size_t)start1] = current;
+
+    fifo.finishedWrite(size1);
+}
+
+int Profiler::readFrames(ProfileFrame* destination, int maxFrames) noexcept
+{
+    int start1, size1, start2, size2;
+    fifo.prepareToRead(maxFrames, start1, size1, start2, size2);
+
+    std::copy_n(frames.begin() + start1, size1, destination);
+    std::copy_n(frames.begin() + start2, size2, destination + size1);
+
+    fifo.finishedRead(size1 + size2);
+    return size1 + size2;
+}
@@ -0,0 +1,128 @@
+/*
+  ==============================================================================
+
+    Profiler.h
+    Created: 19 Oct 2026
+    Author:  woz
+    Notes: Per stage cycle counts for processBlock and the voices.
+
+           Build with SYMPLE_PROFILING=1 to turn it on. Without it the
+           SYMPLE_PROFILE_* macros expand to nothing, so release builds pay
+           nothing for the instrumentation.
+
+           The audio thread adds cycles to the frame of the current block and
+           pushes the finished frame into a wait-free single producer, single
+           consumer fifo. The editor overlay is the consumer. If it falls
+           behind, frames are dropped rather than making the audio thread wait.
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+#if JUCE_INTEL
+ #if JUCE_MSVC
+  #include <intrin.h>
+ #else
+  #include <x86intrin.h>
+ #endif
+#endif
+
+#ifndef SYMPLE_PROFILING
+ #define SYMPLE_PROFILING 0
+#endif
+
+enum class ProfileStage
+{
+    Lfo,
+    Oscillators,
+    Noise,
+    Envelopes,
+    Filters,
+    VoiceKernel,    // the fused oscillator, noise and filter kernel
+    Oversampling,   // downsampling the High quality tier
+    Eq,             // the master EQ on the voice mix
+    Effects,        // chorus and tempo delay on the voice mix
+    MasterGain,
+    Reverb,
+    Limiter,        // soft clipper and true peak limiter
+    NumStages
+};
+
+struct ProfileFrame
+{
+    std::array<juce::uint64, (size_t)ProfileStage::NumStages> stageCycles {};
+    juce::uint64 blockCycles = 0;
+    int numSamples = 0;
+    int activeVoices = 0;
+    int steals = 0;
+    float deadlineUsed = 0.0f; // wall time of the block over numSamples / sampleRate
+};
+
+class Profiler
+{
+public:
+    /* Time stamp counter where there is one, high resolution ticks elsewhere */
+    static juce::uint64 readCycleCounter() noexcept
+    {
+       #if JUCE_INTEL
+        return (juce::uint64)__rdtsc();
+       #else
+        return (juce::uint64)juce::Time::getHighResolutionTicks();
+       #endif
+    }
+
+    static const char* getStageName(ProfileStage stage) noexcept;
+
+    //==============================================================================
+    // audio thread
+
+    void beginBlock(int numSamples, double sampleRate) noexcept;
+    void endBlock(int activeVoices) noexcept;
+    void addStageCycles(ProfileStage stage, juce::uint64 cycles) noexcept { current.stageCycles[(size_t)stage] += cycles; }
+    void addSteal() noexcept { ++current.steals; }
+
+    struct ScopedStage
+    {
+        ScopedStage(Profiler* p, ProfileStage s) noexcept : profiler(p), stage(s), start(readCycleCounter()) {}
+        ~ScopedStage() noexcept
+        {
+            if (profiler != nullptr)
+                profiler->addStageCycles(stage, readCycleCounter() - start);
+        }
+
+        Profiler* profiler;
+        ProfileStage stage;
+        juce::uint64 start;
+    };
+
+    //==============================================================================
+    // message thread
+
+    /* Copies out up to maxFrames finished frames, returns how many */
+    int readFrames(ProfileFrame* destination, int maxFrames) noexcept;
+
+private:
+    static constexpr int fifoSize = 256;
+
+    juce::AbstractFifo fifo { fifoSize };
+    std::array<ProfileFrame, fifoSize> frames;
+
+    ProfileFrame current;
+    juce::int64 blockStartTicks = 0;
+    juce::uint64 blockStartCycles = 0;
+    double deadlineSeconds = 0.0;
+};
+
+#if SYMPLE_PROFILING
+ #define SYMPLE_PROFILE_STAGE(profiler, stage)   const Profiler::ScopedStage JUCE_JOIN_MACRO (profileStage, __LINE__) (profiler, stage)
+ #define SYMPLE_PROFILE_BEGIN_BLOCK(profiler, numSamples, sampleRate)   (profiler).beginBlock (numSamples, sampleRate)
+ #define SYMPLE_PROFILE_END_BLOCK(profiler, activeVoices)   (profiler).endBlock (activeVoices)
+ #define SYMPLE_PROFILE_STEAL(profiler)   if ((profiler) != nullptr) (profiler)->addSteal()
+#else
+ #define SYMPLE_PROFILE_STAGE(profiler, stage)
+ #define SYMPLE_PROFILE_BEGIN_BLOCK(profiler, numSamples, sampleRate)
+ #define SYMPLE_PROFILE_END_BLOCK(profiler, activeVoices)
+ #define SYMPLE_PROFILE_STEAL(profiler)
+#endif
@@ -0,0 +1,107 @@
+/*
+  ==============================================================================
+
+    ProfilerOverlay.cpp
+    Created: 19 Oct 2026
+    Author:  woz
+
+  ==============================================================================
+*/
+
+#include "ProfilerOverlay.h"
+
+#if SYMPLE_PROFILING
+
+ProfilerOverlay::ProfilerOverlay(Profiler& p)
+    : profiler(p)
+{
+    setInterceptsMouseClicks(false, false);
+    startTimerHz(15);
+}
+
+ProfilerOverlay::~ProfilerOverlay()
+{
+    stopTimer();
+}
+
+void ProfilerOverlay::timerCallback()
+{
+    std::array<juce::uint64, (size_t)numStages> stageCycles {};
+    juce::uint64 blockCycles = 0;
+    float deadline = 0.0f;
+    float voices = 0.0f;
+    int numFrames = 0;
+
+    // empty the fifo, the audio thread drops frames when it is full
+    for (int read = profiler.readFrames(incoming.data(), (int)incoming.size()); read > 0;
+         read = profiler.readFrames(incoming.data(), (int)incoming.size()))
+    {
+        for (int i = 0; i < read; ++i)
+        {
+            auto& frame = incoming[(size_t)i];
+
+            for (size_t stage = 0; stage < stageCycles.size(); ++stage)
+                stageCycles[stage] += frame.stageCycles[stage];
+
+            blockCycles += frame.blockCycles;
+            deadline += frame.deadlineUsed;
+            voices += (float)frame.activeVoices;
+            steals += frame.steals;
+            peakDeadline = juce::jmax(peakDeadline, frame.deadlineUsed);
+        }
+
+        numFrames += read;
+    }
+
+    if (numFrames == 0)
+        return;
+
+    for (size_t stage = 0; stage < stageShare.size(); ++stage)
+        stageShare[stage] = blockCycles > 0 ? (float)((double)stageCycles[stage] / (double)blockCycles) : 0.0f;
+
+    averageDeadline = deadline / numFrames;
+    averageVoices = voices / numFrames;
+    peakDeadline *= 0.95f;
+
+    repaint();
+}
+
+void ProfilerOverlay::paint(juce::Graphics& g)
+{
+    g.fillAll(juce::Colours::black.withAlpha(0.75f));
+    g.setFont(12.0f);
+
+    auto area = getLocalBounds().reduced(6);
+    const int rowHeight = 16;
+
+    auto drawRow = [&] (const juce::String& name, float share, const juce::String& value, juce::Colour colour)
+    {
+        auto row = area.removeFromTop(rowHeight);
+        g.setColour(juce::Colours::white);
+        g.drawText(name, row.removeFromLeft(80), juce::Justification::centredLeft);
+        g.drawText(value, row.removeFromRight(60), juce::Justification::centredRight);
+
+        auto bar = row.reduced(4, 3);
+        g.setColour(juce::Colours::darkgrey);
+        g.fillRect(bar);
+        g.setColour(colour);
+        g.fillRect(bar.withWidth(juce::roundToInt(bar.getWidth() * juce::jlimit(0.0f, 1.0f, share))));
+    };
+
+    const auto deadlineColour = averageDeadline > 0.8f ? juce::Colours::red
+                              : averageDeadline > 0.5f ? juce::Colours::orange
+                                                       : juce::Colours::limegreen;
+
+    drawRow("Deadline", averageDeadline, juce::String(averageDeadline * 100.0f, 1) + "%", deadlineColour);
+    drawRow("Peak", peakDeadline, juce::String(peakDeadline * 100.0f, 1) + "%", deadlineColour);
+
+    for (int stage = 0; stage < numStages; ++stage)
+        drawRow(Profiler::getStageName((ProfileStage)stage), stageShare[(size_t)stage],
+                juce::String(stageShare[(size_t)stage] * 100.0f, 1) + "%", juce::Colours::skyblue);
+
+    g.setColour(juce::Colours::white);
+    g.drawText("Voices " + juce::String(averageVoices, 1) + "   Steals " + juce::String(steals),
+               area.removeFromTop(rowHeight), juce::Justification::centredLeft);
+}
+
+#endif
@@ -0,0 +1,42 @@
+/*
+  ==============================================================================
+
+    ProfilerOverlay.h
+    Created: 19 Oct 2026
+    Author:  woz
+    Notes: Shows the Profiler frames on top of the editor. Only built into the
+           editor when SYMPLE_PROFILING is on, without it ProfilerOverlay.cpp
+           compiles to nothing.
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "Profiler.h"
+
+class ProfilerOverlay : public juce::Component, private juce::Timer
+{
+public:
+    explicit ProfilerOverlay(Profiler& profiler);
+    ~ProfilerOverlay() override;
+
+    void paint(juce::Graphics&) override;
+
+private:
+    static constexpr int numStages = (int)ProfileStage::NumStages;
+
+    Profiler& profiler;
+    std::array<ProfileFrame, 64> incoming;
+
+    // averages over the frames read since the last repaint, peaks decay slowly
+    std::array<float, (size_t)numStages> stageShare {};
+    float averageDeadline = 0.0f;
+    float peakDeadline = 0.0f;
+    float averageVoices = 0.0f;
+    int steals = 0;
+
+    void timerCallback() override;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ProfilerOverlay)
+};
@@ -0,0 +1,119 @@
+/*
+  ==============================================================================
+
+    RateContext.cpp
+    Created: 19 Oct 2026
+    Author:  woz
+
+  ==============================================================================
+*/
+
+#include "RateContext.h"
+
+std::unique_ptr<RateContext> RateContext::build(double hostRate)
+{
+    auto context = std::make_unique<RateContext>();
+    context->hostRate = hostRate;
+
+    for (int tier = 0; tier < numTiers; ++tier)
+    {
+        const auto settings = RenderQualityTiers::getSettings((RenderQuality)tier);
+        auto& rates = context->tiers[tier];
+
+        rates.sampleRate = hostRate * settings.oversamplingFactor;
+        rates.controlInterval = juce::jmax(1, juce::roundToInt(RateContextConstants::paramUpdateRate * settings.controlRateFactor));
+
+        // per sample modulation: each new cutoff is ramped to over one control
+        // interval, so the cutoff moves every sample between updates
+        rates.filterSmoothingTime = settings.perSampleModulation ? (float)((rates.controlInterval + 0.5) / rates.sampleRate)
+                                                                 : RateContextConstants::filterSmoothingTime;
+
+        for (int note = 0; note < RateContextConstants::numNotes; ++note)
+            rates.noteIncrement[note] = juce::MathConstants<double>::twoPi * juce::MidiMessage::getMidiNoteInHertz(note) / rates.sampleRate;
+    }
+
+    return context;
+}
+
+//==============================================================================
+RateContextBuilder::RateContextBuilder()
+    : juce::Thread("SympleSynth rate contexts")
+{
+    // most hosts run at one of these
+    for (auto rate : { 44100.0, 48000.0, 88200.0, 96000.0 })
+        pendingRates.add(rate);
+
+    startThread();
+}
+
+RateContextBuilder::~RateContextBuilder()
+{
+    stopThread(1000);
+}
+
+const RateContext* RateContextBuilder::getContext(double hostRate)
+{
+    jassert(hostRate > 0.0);
+
+    for (int attempt = 0; attempt < 100; ++attempt)
+    {
+        {
+            const juce::ScopedLock sl (lock);
+            if (auto* context = findContext(hostRate))
+                return context;
+
+            requestRate(hostRate);
+        }
+
+        contextBuilt.wait(10);
+    }
+
+    // the builder thread isn't running, so build it here
+    auto context = RateContext::build(hostRate);
+    const juce::ScopedLock sl (lock);
+    return contexts.add(context.release());
+}
+
+const RateContext* RateContextBuilder::findContext(double hostRate) const
+{
+    for (auto* context : contexts)
+        if (context->hostRate == hostRate)
+            return context;
+
+    return nullptr;
+}
+
+void RateContextBuilder::requestRate(double hostRate)
+{
+    pendingRates.addIfNotAlreadyThere(hostRate);
+    notify();
+}
+
+void RateContextBuilder::run()
+{
+    while (!threadShouldExit())
+    {
+        double rate = 0.0;
+        {
+            const juce::ScopedLock sl (lock);
+            if (!pendingRates.isEmpty())
+                rate = pendingRates.removeAndReturn(0);
+        }
+
+        if (rate <= 0.0)
+        {
+            wait(-1);
+            continue;
+        }
+
+        auto context = RateContext::build(rate);
+
+        {
+            const juce::ScopedLock sl (lock);
+            if (findContext(rate) == nullptr)
+                contexts.add(context.release());
+        }
+
+        contextBuilt.signal();
+    }
+}
@@ -0,0 +1,87 @@
+/*
+  ==============================================================================
+
+    RateContext.h
+    Created: 19 Oct 2026
+    Author:  woz
+    Notes: Everything the voices derive from the host sample rate, worked out
+           once per rate for every quality tier: the rate the voices run at,
+           the control interval, the filter smoothing time and the phase
+           increment of every midi note.
+
+           Contexts are built by a background thread shared by every plugin
+           instance, which starts with the common host rates. prepareToPlay
+           asks for its rate and only waits if that rate hasn't been built
+           yet. The processor publishes the context through an atomic
+           pointer and the audio thread picks it up at the start of a block.
+           A context is never changed or freed once built, so a pointer to
+           one stays valid for as long as the builder lives.
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "RenderQuality.h"
+
+namespace RateContextConstants
+{
+    constexpr int paramUpdateRate = 100;            // samples per cutoff update at the Normal tier
+    constexpr float filterSmoothingTime = 0.05f;    // seconds, when cutoffs only move at control rate
+    constexpr int numNotes = 128;
+}
+
+/* What a voice needs for one quality tier at one host rate */
+struct VoiceRates
+{
+    double sampleRate = 0.0;        // the host rate times the tier's oversampling factor
+    int controlInterval = RateContextConstants::paramUpdateRate; // before the CPU governor scales it
+    float filterSmoothingTime = RateContextConstants::filterSmoothingTime;
+    double noteIncrement[RateContextConstants::numNotes] {}; // radians per sample
+
+    /* Phase increment of a midi note, notes outside 0 - 127 are worked out on the spot */
+    double getNoteIncrement(int midiNoteNumber) const
+    {
+        if (juce::isPositiveAndBelow(midiNoteNumber, RateContextConstants::numNotes))
+            return noteIncrement[midiNoteNumber];
+
+        return juce::MathConstants<double>::twoPi * juce::MidiMessage::getMidiNoteInHertz(midiNoteNumber) / sampleRate;
+    }
+};
+
+struct RateContext
+{
+    static constexpr int numTiers = (int)RenderQuality::Offline + 1;
+
+    double hostRate = 0.0;
+    VoiceRates tiers[numTiers];
+
+    const VoiceRates& getVoiceRates(RenderQuality quality) const { return tiers[(int)quality]; }
+
+    static std::unique_ptr<RateContext> build(double hostRate);
+};
+
+/* Hold one through a juce::SharedResourcePointer<RateContextBuilder> */
+class RateContextBuilder : private juce::Thread
+{
+public:
+    RateContextBuilder();
+    ~RateContextBuilder() override;
+
+    /* The context for a host rate, waiting for the background thread to
+       build it if it hasn't already. Call from prepareToPlay, never from
+       the audio thread */
+    const RateContext* getContext(double hostRate);
+
+private:
+    juce::CriticalSection lock;
+    juce::OwnedArray<RateContext> contexts; // every rate built so far, freed with the builder
+    juce::Array<double> pendingRates;
+    juce::WaitableEvent contextBuilt;
+
+    const RateContext* findContext(double hostRate) const;
+    void requestRate(double hostRate);
+    void run() override;
+
+    JUCE_DECLARE_NON_COPYABLE (RateContextBuilder)
+};
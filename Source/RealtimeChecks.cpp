@@ -0,0 +1,97 @@
+/*
+  ==============================================================================
+
+    RealtimeChecks.cpp
+    Created: 19 Oct 2026
+    Author:  woz
+
+  ==============================================================================
+*/
+
+#include "RealtimeChecks.h"
+
+namespace
+{
+    // plain thread locals, the hooks read them from inside malloc
+    thread_local int realtimeDepth = 0;
+    thread_local bool reporting = false;
+    thread_local int numViolations = 0;
+
+    std::atomic<int> numReported { 0 };
+    std::atomic<bool> strictLocking { false };
+
+    constexpr int maxReported = 20;
+
+    const char* getViolationName(RealtimeChecks::Violation violation) noexcept
+    {
+        switch (violation)
+        {
+        case RealtimeChecks::Violation::Allocation:     return "allocation";
+        case RealtimeChecks::Violation::Deallocation:   return "deallocation";
+        case RealtimeChecks::Violation::Lock:           return "lock";
+        case RealtimeChecks::Violation::ContendedLock:  return "contended lock";
+        }
+
+        return "";
+    }
+}
+
+bool RealtimeChecks::isInRealtimeScope() noexcept
+{
+    return realtimeDepth > 0 && !reporting;
+}
+
+void RealtimeChecks::report(Violation violation, const char* function) noexcept
+{
+    if (reporting)
+        return;
+
+    ++numViolations;
+
+    const int count = ++numReported;
+    if (count > maxReported)
+        return;
+
+    // printing allocates, don't report the report
+    reporting = true;
+
+    juce::String message;
+    message << "realtime violation: " << getViolationName(violation) << " in " << function
+            << " on the audio thread" << juce::newLine << juce::SystemStats::getStackBacktrace();
+
+    if (count == maxReported)
+        message << "further violations are counted but not printed" << juce::newLine;
+
+    juce::Logger::outputDebugString(message);
+    reporting = false;
+}
+
+int RealtimeChecks::getNumViolations() noexcept
+{
+    return numViolations;
+}
+
+void RealtimeChecks::resetViolations() noexcept
+{
+    numViolations = 0;
+}
+
+void RealtimeChecks::setStrictLocking(bool shouldReportAllLocks) noexcept
+{
+    strictLocking = shouldReportAllLocks;
+}
+
+bool RealtimeChecks::isStrictLocking() noexcept
+{
+    return strictLocking.load(std::memory_order_relaxed);
+}
+
+RealtimeChecks::ScopedRealtime::ScopedRealtime() noexcept
+{
+    ++realtimeDepth;
+}
+
+RealtimeChecks::ScopedRealtime::~ScopedRealtime() noexcept
+{
+    --realtimeDepth;
+}
@@ -0,0 +1,62 @@
+/*
+  ==============================================================================
+
+    RealtimeChecks.h
+    Created: 19 Oct 2026
+    Author:  woz
+    Notes: Debug mode that catches the audio thread allocating, freeing or
+           waiting on a lock.
+
+           Build with SYMPLE_REALTIME_CHECKS=1. processBlock then marks the
+           audio thread as realtime for its duration, and the hooks in
+           Tools/SympleRender/Source/RealtimeHooks.cpp (linked into the
+           console tools only, never into the plugin) report every operator
+           new/delete, malloc/free and blocked mutex seen in that scope, with
+           a stack trace.
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+#ifndef SYMPLE_REALTIME_CHECKS
+ #define SYMPLE_REALTIME_CHECKS 0
+#endif
+
+namespace RealtimeChecks
+{
+    enum class Violation
+    {
+        Allocation,
+        Deallocation,
+        Lock,           // an uncontended lock, only reported with strict locking
+        ContendedLock   // the audio thread had to wait for another thread
+    };
+
+    /* True on a thread that is inside a realtime scope and not reporting */
+    bool isInRealtimeScope() noexcept;
+
+    /* Called by the hooks. Prints the first violations with a stack trace and counts the rest */
+    void report(Violation violation, const char* function) noexcept;
+
+    /* Counted per thread, so renders running side by side each see their own */
+    int getNumViolations() noexcept;
+    void resetViolations() noexcept;
+
+    /* Reports every lock taken on the audio thread, not just the ones that block */
+    void setStrictLocking(bool shouldReportAllLocks) noexcept;
+    bool isStrictLocking() noexcept;
+
+    struct ScopedRealtime
+    {
+        ScopedRealtime() noexcept;
+        ~ScopedRealtime() noexcept;
+    };
+}
+
+#if SYMPLE_REALTIME_CHECKS
+ #define SYMPLE_REALTIME_SCOPE()   const RealtimeChecks::ScopedRealtime JUCE_JOIN_MACRO (realtimeScope, __LINE__)
+#else
+ #define SYMPLE_REALTIME_SCOPE()
+#endif
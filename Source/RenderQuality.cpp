@@ -0,0 +1,42 @@
+/*
+  ==============================================================================
+
+    RenderQuality.cpp
+    Created: 19 Oct 2026
+    Author:  woz
+
+  ==============================================================================
+*/
+
+#include "RenderQuality.h"
+
+RenderQualitySettings RenderQualityTiers::getSettings(RenderQuality quality)
+{
+    switch (quality)
+    {
+    case RenderQuality::Eco:     return { 4.0f, false, 1, false };
+    case RenderQuality::Normal:  return { 1.0f, true, 1, false };
+    case RenderQuality::High:    return { 1.0f, true, maxOversamplingFactor, true };
+    case RenderQuality::Offline: return { 0.25f, true, maxOversamplingFactor, true };
+    }
+
+    return { 1.0f, true, 1, false };
+}
+
+const char* RenderQualityTiers::getName(RenderQuality quality)
+{
+    switch (quality)
+    {
+    case RenderQuality::Eco:     return "Eco";
+    case RenderQuality::Normal:  return "Normal";
+    case RenderQuality::High:    return "High";
+    case RenderQuality::Offline: return "Offline";
+    }
+
+    return "Normal";
+}
+
+RenderQuality RenderQualityTiers::fromParameter(float value)
+{
+    return static_cast<RenderQuality> (juce::jlimit(0, 2, juce::roundToInt(value)));
+}
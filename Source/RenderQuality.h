@@ -0,0 +1,49 @@
+/*
+  ==============================================================================
+
+    RenderQuality.h
+    Created: 19 Oct 2026
+    Author:  woz
+    Notes: The Eco / Normal / High tiers selected with the QUALITY parameter.
+           A tier changes how the voices are computed, not the patch:
+
+               Eco      naive waveforms, a quarter of the normal control rate
+               Normal   polyBLEP waveforms, cutoffs updated every
+                        paramUpdateRate samples (RateContext.h)
+               High     2x oversampled voices with cutoffs that glide every
+                        sample between control rate updates
+               Offline  High with four times the control rate, used for
+                        every non-realtime render whatever QUALITY says
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+enum class RenderQuality
+{
+    Eco,
+    Normal,
+    High,
+    Offline     // not selectable, see SympleSynthAudioProcessor::setNonRealtime
+};
+
+struct RenderQualitySettings
+{
+    float controlRateFactor;    // multiplies RateContextConstants::paramUpdateRate
+    bool bandLimited;           // polyBLEP oscillators, naive waveforms when false
+    int oversamplingFactor;     // voices run at this multiple of the host rate
+    bool perSampleModulation;   // filter cutoffs ramp across each control interval
+};
+
+namespace RenderQualityTiers
+{
+    constexpr int maxOversamplingFactor = 2;
+
+    RenderQualitySettings getSettings(RenderQuality);
+    const char* getName(RenderQuality);
+
+    /* Converts the value of the QUALITY parameter */
+    RenderQuality fromParameter(float value);
+}
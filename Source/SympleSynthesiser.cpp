@@ -0,0 +1,160 @@
+/*
+  ==============================================================================
+
+    SympleSynthesiser.cpp
+    Created: 19 Oct 2026
+    Author:  woz
+
+  ==============================================================================
+*/
+
+#include "SympleSynthesiser.h"
+
+void SympleSynthesiser::setSilenceThreshold(float decibels)
+{
+    const juce::ScopedLock sl (lock);
+
+    for (auto* voice : voices)
+        static_cast<SynthVoice*>(voice)->setSilenceThreshold(decibels);
+}
+
+void SympleSynthesiser::setMaxActiveVoices(int numVoices)
+{
+    const juce::ScopedLock sl (lock);
+    maxActiveVoices = juce::jmax(1, numVoices);
+}
+
+void SympleSynthesiser::setControlRateScale(int scale)
+{
+    const juce::ScopedLock sl (lock);
+
+    for (auto* voice : voices)
+        static_cast<SynthVoice*>(voice)->setControlRateScale(scale);
+}
+
+void SympleSynthesiser::setVoiceRenderPool(VoiceRenderPool* pool)
+{
+    const juce::ScopedLock sl (lock);
+    renderPool = pool;
+}
+
+void SympleSynthesiser::renderVoices(juce::AudioBuffer<float>& outputAudio, int startSample, int numSamples)
+{
+    if (renderPool != nullptr && renderPool->getNumWorkers() > 0)
+        renderPool->render(voices, outputAudio, startSample, numSamples);
+    else
+        juce::Synthesiser::renderVoices(outputAudio, startSample, numSamples);
+}
+
+/*
+ *  Once the cap is reached a new note has to take over a playing voice,
+ *  even if the synth has idle ones left.
+ */
+juce::SynthesiserVoice* SympleSynthesiser::findFreeVoice(juce::SynthesiserSound* soundToPlay, int midiChannel,
+                                                         int midiNoteNumber, bool stealIfNoneAvailable) const
+{
+    if (maxActiveVoices < voices.size())
+    {
+        int numActive = 0;
+        for (auto* voice : voices)
+            if (voice->isVoiceActive())
+                ++numActive;
+
+        if (numActive >= maxActiveVoices)
+            return stealIfNoneAvailable ? findVoiceToSteal(soundToPlay, midiChannel, midiNoteNumber) : nullptr;
+    }
+
+    return juce::Synthesiser::findFreeVoice(soundToPlay, midiChannel, midiNoteNumber, stealIfNoneAvailable);
+}
+
+/*
+ *  Puts the quietest held voices into their release until no more than
+ *  maxActiveVoices are held. Voices that are already releasing fade out or
+ *  get cut by the silence threshold. A note that hasn't rendered yet has no
+ *  level to compare, so it is only released when every held voice is new.
+ */
+void SympleSynthesiser::releaseVoicesOverLimit()
+{
+    if (maxActiveVoices >= voices.size())
+        return;
+
+    for (;;)
+    {
+        int numHeld = 0;
+        SynthVoice* quietest = nullptr;
+        SynthVoice* firstUnrendered = nullptr;
+
+        for (auto* voice : voices)
+        {
+            auto* synthVoice = static_cast<SynthVoice*>(voice);
+            if (!synthVoice->isVoiceActive() || synthVoice->hasReceivedNoteOff())
+                continue;
+
+            ++numHeld;
+            if (!synthVoice->hasOutputLevel())
+            {
+                if (firstUnrendered == nullptr)
+                    firstUnrendered = synthVoice;
+            }
+            else if (quietest == nullptr || synthVoice->getOutputLevel() < quietest->getOutputLevel())
+            {
+                quietest = synthVoice;
+            }
+        }
+
+        if (quietest == nullptr)
+            quietest = firstUnrendered;
+
+        if (numHeld <= maxActiveVoices || quietest == nullptr)
+            return;
+
+        stopVoice(quietest, 0.0f, true);
+    }
+}
+
+/*
+ *  Picks the quietest voice that is already in its release stage. If every
+ *  voice is still held, fall back to the default juce stealing rules which
+ *  protect the lowest and highest notes.
+ */
+juce::SynthesiserVoice* SympleSynthesiser::findVoiceToSteal(juce::SynthesiserSound* soundToPlay,
+                                                            int midiChannel,
+                                                            int midiNoteNumber) const
+{
+    SYMPLE_PROFILE_STEAL(profiler);
+
+    SynthVoice* quietest = nullptr;
+
+    for (auto* voice : voices)
+    {
+        auto* synthVoice = static_cast<SynthVoice*>(voice);
+
+        if (!synthVoice->canPlaySound(soundToPlay) || !synthVoice->isReleasing() || synthVoice->isKeyDown())
+            continue;
+
+        if (quietest == nullptr || synthVoice->getOutputLevel() < quietest->getOutputLevel())
+            quietest = synthVoice;
+    }
+
+    if (quietest != nullptr)
+        return quietest;
+
+    return juce::Synthesiser::findVoiceToSteal(soundToPlay, midiChannel, midiNoteNumber);
+}
+
+void SympleSynthesiser::renderBlock(juce::AudioBuffer<float>& outputAudio, const juce::MidiBuffer& inputMidi,
+                                    int startSample, int numSamples)
+{
+    const juce::ScopedLock sl (lock);
+    const int end = startSample + numSamples;
+
+    for (const auto metadata : inputMidi)
+    {
+        currentEventSample = juce::jlimit(startSample, end, metadata.samplePosition);
+        handleMidiEvent(metadata.getMessage());
+    }
+
+    currentEventSample = -1;
+    releaseVoicesOverLimit();
+    renderVoices(outputAudio, startSample, numSamples);
+}
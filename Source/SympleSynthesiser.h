@@ -0,0 +1,62 @@
+/*
+  ==============================================================================
+
+    SympleSynthesiser.h
+    Created: 19 Oct 2026
+    Author:  woz
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "Voice.h"
+#include "VoiceRenderPool.h"
+
+/* The juce Synthesiser with voice stealing that knows how loud each SynthVoice is.
+   Released voices are stolen quietest first, so a long release tail that can
+   barely be heard goes before any note that is still being held. */
+class SympleSynthesiser : public juce::Synthesiser
+{
+public:
+    /* Sets the level (in dB) below which released voices are freed early */
+    void setSilenceThreshold(float decibels);
+
+    /* Handles every midi event of the block up front, with each voice queueing
+       its note events at their sample positions, then renders every voice once.
+       Unlike juce::Synthesiser::renderNextBlock the block is not split at each
+       event, so the fixed per render cost of the voices does not grow with
+       the number of midi events. */
+    void renderBlock(juce::AudioBuffer<float>& outputAudio, const juce::MidiBuffer& inputMidi, int startSample, int numSamples);
+
+    /* The sample position of the midi event being handled, or -1 outside
+       renderBlock, in which case voices apply their events at the next render */
+    const int& getCurrentEventSample() const { return currentEventSample; }
+
+    /* Caps how many voices may sound at once, below the number of voices the
+       synth owns. Held voices over the cap are released quietest first */
+    void setMaxActiveVoices(int numVoices);
+
+    /* Multiplies the control interval of every voice, see CpuGovernor */
+    void setControlRateScale(int scale);
+
+    /* Spreads the voices over the pool's threads when it has any, for
+       non-realtime renders. Pass nullptr to render on the calling thread */
+    void setVoiceRenderPool(VoiceRenderPool* pool);
+
+    /* Counts voice steals, see Profiler.h */
+    void setProfiler(Profiler* newProfiler) { profiler = newProfiler; }
+
+protected:
+    juce::SynthesiserVoice* findFreeVoice(juce::SynthesiserSound*, int midiChannel, int midiNoteNumber, bool stealIfNoneAvailable) const override;
+    juce::SynthesiserVoice* findVoiceToSteal(juce::SynthesiserSound*, int midiChannel, int midiNoteNumber) const override;
+    void renderVoices(juce::AudioBuffer<float>& outputAudio, int startSample, int numSamples) override;
+
+private:
+    int currentEventSample = -1;
+    int maxActiveVoices = std::numeric_limits<int>::max();
+    VoiceRenderPool* renderPool = nullptr;
+
+    void releaseVoicesOverLimit();
+    Profiler* profiler = nullptr;
+};
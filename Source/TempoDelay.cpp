@@ -0,0 +1,127 @@
+/*
+  ==============================================================================
+
+    TempoDelay.cpp
+    Created: 19 Oct 2026
+    Author:  woz
+
+  ==============================================================================
+*/
+
+#include "TempoDelay.h"
+
+namespace
+{
+    struct Division { const char* name; double beats; };
+
+    const Division divisions[DelayDivisions::numDivisions] =
+    {
+        { "1/16",  0.25 },
+        { "1/8T",  1.0 / 3.0 },
+        { "1/8",   0.5 },
+        { "1/8.",  0.75 },
+        { "1/4",   1.0 },
+        { "1/4.",  1.5 },
+        { "1/2",   2.0 },
+    };
+
+    const Division& getDivision(float value)
+    {
+        return divisions[juce::jlimit(0, DelayDivisions::numDivisions - 1, juce::roundToInt(value))];
+    }
+}
+
+double DelayDivisions::getBeats(float value) { return getDivision(value).beats; }
+const char* DelayDivisions::getName(float value) { return getDivision(value).name; }
+
+//==============================================================================
+
+double TempoDelay::getTailLengthSeconds(double delayTime, float feedback)
+{
+    // every repeat is feedback times quieter than the one before
+    const double gain = juce::jlimit(0.0, (double)maxFeedback, (double)feedback);
+    const int repeats = gain > 0.001 ? (int)std::ceil(std::log(0.001) / std::log(gain)) : 0;
+
+    return delayTime * (repeats + 1);
+}
+
+void TempoDelay::prepare(double newSampleRate, int newNumChannels)
+{
+    sampleRate = newSampleRate;
+    numChannels = juce::jmin(newNumChannels, maxChannels);
+
+    for (auto& line : lines)
+        line.prepare((int)std::ceil(maxDelayTime * sampleRate));
+
+    reset();
+}
+
+void TempoDelay::reset()
+{
+    for (auto& line : lines)
+        line.reset();
+
+    currentDelay = 0.0f;
+}
+
+void TempoDelay::setParameters(float delayTime, float newFeedback, float newMix)
+{
+    const float samples = juce::jmin(delayTime, maxDelayTime) * (float)sampleRate;
+    targetDelay = juce::jlimit(ModulatedDelay::getMinimumDelay(), lines[0].getMaximumDelay(), samples);
+
+    // the first setting after prepare is jumped to rather than glided to
+    if (currentDelay <= 0.0f)
+        currentDelay = targetDelay;
+
+    feedback = juce::jlimit(0.0f, maxFeedback, newFeedback);
+    mix = juce::jlimit(0.0f, 1.0f, newMix);
+}
+
+void TempoDelay::process(juce::AudioBuffer<float>& buffer, int numSamples)
+{
+    const int channels = juce::jmin(numChannels, buffer.getNumChannels());
+    if (channels == 0)
+        return;
+
+    // off: the lines take the dry signal without feedback, so switching on
+    // doesn't replay old echoes
+    if (mix <= 0.0f)
+    {
+        for (int channel = 0; channel < channels; ++channel)
+            lines[channel].write(buffer.getReadPointer(channel), numSamples);
+
+        currentDelay = targetDelay;
+        return;
+    }
+
+    for (int start = 0; start < numSamples; start += ModulatedDelay::maxChunk)
+    {
+        const int n = juce::jmin(ModulatedDelay::maxChunk, numSamples - start);
+
+        // one glide step per chunk, ramped across it
+        const float from = currentDelay;
+        const float coefficient = 1.0f - std::exp(-n / (glideTime * (float)sampleRate));
+        currentDelay += (targetDelay - currentDelay) * coefficient;
+        const float step = (currentDelay - from) / n;
+
+        for (int i = 0; i < n; ++i)
+            delays[i] = from + step * (i + 1);
+
+        for (int channel = 0; channel < channels; ++channel)
+            lines[channel].read(delays, echoes[channel], n);
+
+        for (int channel = 0; channel < channels; ++channel)
+        {
+            float* samples = buffer.getWritePointer(channel, start);
+
+            // ping pong: each line is fed the other channel's echoes
+            const int other = channels - 1 - channel;
+            juce::FloatVectorOperations::copy(feed, samples, n);
+            juce::FloatVectorOperations::addWithMultiply(feed, echoes[other], feedback, n);
+            lines[channel].write(feed, n);
+
+            juce::FloatVectorOperations::multiply(samples, 1.0f - mix, n);
+            juce::FloatVectorOperations::addWithMultiply(samples, echoes[channel], mix, n);
+        }
+    }
+}
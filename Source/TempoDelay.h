@@ -0,0 +1,67 @@
+/*
+  ==============================================================================
+
+    TempoDelay.h
+    Created: 19 Oct 2026
+    Author:  woz
+    Notes: Stereo ping pong delay on the voice mix, timed by the processor
+           from the host tempo. Each channel feeds back into the other
+           channel's ModulatedDelay.
+
+           The delay time glides to a new setting at control rate, one step
+           per chunk, so tempo and division changes bend the repeats instead
+           of clicking.
+
+  ==============================================================================
+*/
+
+#pragma once
+#include "ModulatedDelay.h"
+
+/* The note lengths of the DELAY_TIME parameter */
+namespace DelayDivisions
+{
+    constexpr int numDivisions = 7;
+    constexpr int defaultDivision = 3;  // dotted eighth
+
+    /* Converts the value of the DELAY_TIME parameter */
+    double getBeats(float value);
+    const char* getName(float value);
+}
+
+class TempoDelay
+{
+public:
+    static constexpr int maxChannels = 2;
+    static constexpr float maxDelayTime = 2.0f;
+    static constexpr float maxFeedback = 0.95f;
+
+    /* Seconds until the repeats of a delay have died away by 60 dB */
+    static double getTailLengthSeconds(double delayTime, float feedback);
+
+    /* Allocates the delay lines. Not realtime safe */
+    void prepare(double sampleRate, int numChannels);
+    void reset();
+
+    /* delay in seconds, feedback and mix from 0 to 1 */
+    void setParameters(float delayTime, float feedback, float mix);
+
+    /* Processes the first numSamples of buffer in place */
+    void process(juce::AudioBuffer<float>& buffer, int numSamples);
+
+private:
+    static constexpr float glideTime = 0.05f;
+
+    double sampleRate = 44100.0;
+    int numChannels = 0;
+    float targetDelay = 0.0f;
+    float currentDelay = 0.0f;
+    float feedback = 0.0f;
+    float mix = 0.0f;
+
+    ModulatedDelay lines[maxChannels];
+
+    float delays[ModulatedDelay::maxChunk];
+    float echoes[maxChannels][ModulatedDelay::maxChunk];
+    float feed[ModulatedDelay::maxChunk];
+};
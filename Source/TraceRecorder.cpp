@@ -0,0 +1,218 @@
+/*
+  ==============================================================================
+
+    TraceRecorder.cpp
+    Created: 19 Oct 2026
+    Author:  woz
+
+  ==============================================================================
+*/
+
+#include "TraceRecorder.h"
+
+std::atomic<TraceRecorder*> TraceRecorder::activeRecorder { nullptr };
+std::atomic<juce::uint32> TraceRecorder::ringEpoch { 0 };
+
+TraceRecorder::TraceRecorder()
+    : juce::Thread("SympleSynth trace writer")
+{
+}
+
+TraceRecorder::~TraceRecorder()
+{
+    stop();
+}
+
+juce::File TraceRecorder::getDefaultTraceFile()
+{
+    return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+        .getChildFile("SympleSynth")
+        .getChildFile("Traces")
+        .getNonexistentChildFile("trace-" + juce::Time::getCurrentTime().formatted("%Y%m%d-%H%M%S"), ".json");
+}
+
+bool TraceRecorder::start(const juce::File& file)
+{
+    stop();
+
+    file.getParentDirectory().createDirectory();
+    file.deleteFile();
+    stream = std::make_unique<juce::FileOutputStream>(file);
+
+    if (!stream->openedOk())
+    {
+        stream.reset();
+        return false;
+    }
+
+    // nothing can be pushing now, so anything left over from an earlier trace
+    // is thrown away and every thread claims its ring again
+    for (auto& ring : rings)
+    {
+        ring.fifo.reset();
+        ring.claimed = false;
+    }
+    ++ringEpoch;
+
+    firstEvent = true;
+    droppedEvents = 0;
+    startTicks = juce::Time::getHighResolutionTicks();
+    stream->writeText("{\"traceEvents\":[\n", false, false, nullptr);
+
+    recording = true;
+    activeRecorder = this;
+    startThread();
+    return true;
+}
+
+void TraceRecorder::stop()
+{
+    if (stream == nullptr)
+        return;
+
+    stopWriters();
+    stopThread(2000);
+    drain();
+
+    writeRaw("{\"name\":\"dropped events\",\"ph\":\"M\",\"pid\":1,\"args\":{\"count\":"
+             + juce::String((int)droppedEvents.load()) + "}}");
+    stream->writeText("\n],\"displayTimeUnit\":\"ms\"}\n", false, false, nullptr);
+    stream->flush();
+    stream.reset();
+}
+
+/* Once this returns no thread is in push() and none will get past its
+   recording check, so the rings can be drained or reset */
+void TraceRecorder::stopWriters()
+{
+    activeRecorder = nullptr;
+    recording = false;
+
+    while (activeWriters.load() > 0)
+        juce::Thread::yield();
+}
+
+/*
+ *  Each thread claims a ring the first time it records in a trace and keeps
+ *  it until the next start(). Threads beyond the pool size are not traced,
+ *  their events are counted as dropped.
+ */
+TraceRecorder::ThreadRing* TraceRecorder::getRingForThisThread() noexcept
+{
+    thread_local const TraceRecorder* owner = nullptr;
+    thread_local juce::uint32 epoch = 0;
+    thread_local ThreadRing* ring = nullptr;
+
+    const auto currentEpoch = ringEpoch.load(std::memory_order_relaxed);
+
+    if (owner != this || epoch != currentEpoch)
+    {
+        owner = this;
+        epoch = currentEpoch;
+        ring = nullptr;
+
+        for (auto& candidate : rings)
+        {
+            bool expected = false;
+            if (candidate.claimed.compare_exchange_strong(expected, true))
+            {
+                ring = &candidate;
+                break;
+            }
+        }
+    }
+
+    return ring;
+}
+
+void TraceRecorder::push(const TraceEvent& event) noexcept
+{
+    // counted in before the recording check, see stopWriters()
+    activeWriters.fetch_add(1);
+
+    if (recording.load())
+    {
+        auto* ring = getRingForThisThread();
+        int start1, size1, start2, size2;
+
+        if (ring != nullptr)
+            ring->fifo.prepareToWrite(1, start1, size1, start2, size2);
+
+        if (ring != nullptr && size1 > 0)
+        {
+            ring->events[(size_t)start1] = event;
+            ring->fifo.finishedWrite(1);
+        }
+        else
+        {
+            droppedEvents.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    activeWriters.fetch_sub(1);
+}
+
+void TraceRecorder::addComplete(const char* name, juce::int64 eventStart, juce::int64 eventEnd, int argument) noexcept
+{
+    push({ name, eventStart, eventEnd, argument, false });
+}
+
+void TraceRecorder::addInstant(const char* name, int argument) noexcept
+{
+    const auto now = juce::Time::getHighResolutionTicks();
+    push({ name, now, now, argument, true });
+}
+
+void TraceRecorder::run()
+{
+    while (!threadShouldExit())
+    {
+        drain();
+        wait(50);
+    }
+}
+
+void TraceRecorder::drain()
+{
+    for (int threadIndex = 0; threadIndex < maxThreads; ++threadIndex)
+    {
+        auto& ring = rings[(size_t)threadIndex];
+        int start1, size1, start2, size2;
+        ring.fifo.prepareToRead(ring.fifo.getNumReady(), start1, size1, start2, size2);
+
+        for (int i = 0; i < size1; ++i)
+            writeEvent(ring.events[(size_t)(start1 + i)], threadIndex);
+        for (int i = 0; i < size2; ++i)
+            writeEvent(ring.events[(size_t)(start2 + i)], threadIndex);
+
+        ring.fifo.finishedRead(size1 + size2);
+    }
+}
+
+void TraceRecorder::writeEvent(const TraceEvent& event, int threadIndex)
+{
+    const double timestamp = juce::Time::highResolutionTicksToSeconds(event.startTicks - startTicks) * 1.0e6;
+
+    juce::String json;
+    json << "{\"name\":\"" << event.name << "\",\"cat\":\"dsp\",\"pid\":1,\"tid\":" << threadIndex
+         << ",\"ts\":" << juce::String(timestamp, 3);
+
+    if (event.instant)
+        json << ",\"ph\":\"i\",\"s\":\"t\"";
+    else
+        json << ",\"ph\":\"X\",\"dur\":" << juce::String(juce::Time::highResolutionTicksToSeconds(event.endTicks - event.startTicks) * 1.0e6, 3);
+
+    if (event.argument >= 0)
+        json << ",\"args\":{\"value\":" << event.argument << "}";
+
+    writeRaw(json << "}");
+}
+
+void TraceRecorder::writeRaw(const juce::String& json)
+{
+    if (!firstEvent)
+        stream->writeText(",\n", false, false, nullptr);
+
+    firstEvent = false;
+    stream->writeText(json, false, false, nullptr);
+}
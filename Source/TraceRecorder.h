@@ -0,0 +1,114 @@
+/*
+  ==============================================================================
+
+    TraceRecorder.h
+    Created: 19 Oct 2026
+    Author:  woz
+    Notes: Records a timeline of the audio thread in the Chrome trace event
+           format, which chrome://tracing and ui.perfetto.dev can open.
+
+           Tracing is off by default and switched on at runtime with start().
+           While it is off a marker costs one atomic load of the recording
+           instance. While it is on, every thread that records writes fixed
+           size events into its own wait-free ring, claimed from a pool
+           allocated up front, so the audio thread never allocates or locks.
+           A background thread drains the rings and writes the json.
+
+           The recorder is shared through a juce::SharedResourcePointer held
+           by each processor, so it is built on the message thread and never
+           by the first marker on the audio thread. Rings are handed back at
+           every start(), so threads that have come and gone since the last
+           trace don't use up the pool.
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+class TraceRecorder : private juce::Thread
+{
+public:
+    /* Not realtime safe, hold one in a juce::SharedResourcePointer */
+    TraceRecorder();
+    ~TraceRecorder() override;
+
+    /* The recorder while a trace is being written, otherwise nullptr */
+    static TraceRecorder* getRecording() noexcept { return activeRecorder.load(std::memory_order_acquire); }
+
+    /* Starts writing a new trace file. Message thread only */
+    bool start(const juce::File& file);
+    void stop();
+    bool isRecording() const noexcept { return recording.load(std::memory_order_relaxed); }
+
+    static juce::File getDefaultTraceFile();
+
+    //==============================================================================
+    // any thread, names must be string literals
+
+    void addComplete(const char* name, juce::int64 startTicks, juce::int64 endTicks, int argument = -1) noexcept;
+    void addInstant(const char* name, int argument = -1) noexcept;
+
+    struct ScopedEvent
+    {
+        explicit ScopedEvent(const char* eventName) noexcept
+            : name(eventName), startTicks(getRecording() != nullptr ? juce::Time::getHighResolutionTicks() : 0) {}
+
+        ~ScopedEvent() noexcept
+        {
+            if (startTicks != 0)
+                if (auto* recorder = getRecording())
+                    recorder->addComplete(name, startTicks, juce::Time::getHighResolutionTicks());
+        }
+
+        const char* name;
+        juce::int64 startTicks;
+    };
+
+private:
+    struct TraceEvent
+    {
+        const char* name;
+        juce::int64 startTicks;
+        juce::int64 endTicks;   // equal to startTicks for instant events
+        int argument;
+        bool instant;
+    };
+
+    static constexpr int maxThreads = 16;
+    static constexpr int eventsPerThread = 8192;
+
+    struct ThreadRing
+    {
+        std::atomic<bool> claimed { false };
+        juce::AbstractFifo fifo { eventsPerThread };
+        std::array<TraceEvent, eventsPerThread> events;
+    };
+
+    static std::atomic<TraceRecorder*> activeRecorder;
+    static std::atomic<juce::uint32> ringEpoch;     // bumped when the rings are handed back
+
+    std::array<ThreadRing, maxThreads> rings;
+    std::atomic<bool> recording { false };
+    std::atomic<int> activeWriters { 0 };           // threads inside push()
+    std::atomic<juce::uint32> droppedEvents { 0 };
+    juce::int64 startTicks = 0;
+
+    // owned by the writer thread
+    std::unique_ptr<juce::FileOutputStream> stream;
+    bool firstEvent = true;
+
+    ThreadRing* getRingForThisThread() noexcept;
+    void push(const TraceEvent&) noexcept;
+    void stopWriters();
+
+    void run() override;
+    void drain();
+    void writeEvent(const TraceEvent&, int threadIndex);
+    void writeRaw(const juce::String& json);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TraceRecorder)
+};
+
+#define SYMPLE_TRACE_SCOPE(name)   const TraceRecorder::ScopedEvent JUCE_JOIN_MACRO (traceEvent, __LINE__) (name)
+#define SYMPLE_TRACE_INSTANT(name, argument)   do { if (auto* traceRecorder = TraceRecorder::getRecording()) traceRecorder->addInstant (name, argument); } while (false)
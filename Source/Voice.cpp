@@ -10,22 +10,13 @@
 
 #include "Voice.h"
 
-SynthVoice::SynthVoice(juce::AudioProcessorValueTreeState& tree, juce::dsp::AudioBlock<float>& lfoBuffer)
-    : oscTree(tree), lfoBuffer(lfoBuffer)
+SynthVoice::SynthVoice(juce::AudioProcessorValueTreeState& tree, juce::dsp::AudioBlock<float>& lfoBuffer, const int& eventSample)
+    : lfoBuffer(lfoBuffer), oscTree(tree), eventSample(eventSample)
 {
     readParameterState();
 
-    osc1.setSampleRate(getSampleRate());
-    osc2.setSampleRate(getSampleRate());
-    noiseOsc.setSampleRate(getSampleRate());
+    // the oscillator and envelope rates come from setRenderQuality
     noiseOsc.setMode(OSCILLATOR_MODE_NOISE); // always set to noise
-
-    // initialize amplifier envelope
-    ampEnvelope.setSampleRate(getSampleRate());
-    
-    // intialize filter envelope
-    filterEnvelope.setSampleRate(getSampleRate());
-    filter2Envelope.setSampleRate(getSampleRate());
 }
 
 bool SynthVoice::canPlaySound(juce::SynthesiserSound* sound)
@@ -34,9 +25,89 @@ bool SynthVoice::canPlaySound(juce::SynthesiserSound* sound)
 }
 
 // Start the sine tone based on midi input
+// The note starts at the sample of the midi event that triggered it
 
 void SynthVoice::startNote(int midiNoteNumber, float velocity, juce::SynthesiserSound*, int)
 {
+    SYMPLE_TRACE_INSTANT("SynthVoice::startNote", midiNoteNumber);
+    noteOffReceived = false;
+    queueEvent({ eventSample, EVENT_START, midiNoteNumber });
+}
+
+/* Stops the voice by the owning synthesiser calling this function, which must be overriden*/
+
+void SynthVoice::stopNote(float, bool allowTailOff)
+{
+    SYMPLE_TRACE_INSTANT("SynthVoice::stopNote", allowTailOff ? 1 : 0);
+    noteOffReceived = true;
+
+    // the synthesiser wants the voice stopped immediately (e.g. voice stealing).
+    // It expects the voice to be free straight away, the sound is cut when the
+    // event sample is reached
+    if (!allowTailOff)
+    {
+        clearCurrentNote();
+        queueEvent({ eventSample, EVENT_KILL, -1 });
+        return;
+    }
+
+    queueEvent({ eventSample, EVENT_RELEASE, -1 });
+}
+
+/*
+ *  Adds a note event to be applied when rendering reaches its sample
+ */
+void SynthVoice::queueEvent(const PendingEvent& event)
+{
+    // no room left, apply the oldest event early rather than allocate
+    if (numPendingEvents == (int)pendingEvents.size())
+    {
+        applyEvent(pendingEvents[0]);
+        std::move(pendingEvents.begin() + 1, pendingEvents.end(), pendingEvents.begin());
+        --numPendingEvents;
+    }
+
+    pendingEvents[(size_t)numPendingEvents++] = event;
+}
+
+/*
+ *  Applies every queued event at or before the given sample and
+ *  returns the sample of the next event, or end if there is none
+ */
+int SynthVoice::applyEventsUpTo(int sample, int end)
+{
+    int applied = 0;
+    while (applied < numPendingEvents && pendingEvents[(size_t)applied].sample <= sample)
+        applyEvent(pendingEvents[(size_t)applied++]);
+
+    if (applied > 0)
+    {
+        std::move(pendingEvents.begin() + applied, pendingEvents.begin() + numPendingEvents, pendingEvents.begin());
+        numPendingEvents -= applied;
+    }
+
+    return numPendingEvents > 0 ? juce::jmin(end, pendingEvents[0].sample) : end;
+}
+
+void SynthVoice::applyEvent(const PendingEvent& event)
+{
+    switch (event.type)
+    {
+    case EVENT_START:   beginNote(event.midiNoteNumber);  break;
+    case EVENT_RELEASE: releaseNote();                    break;
+    case EVENT_KILL:    resetNote();                      break;
+    }
+}
+
+void SynthVoice::beginNote(int midiNoteNumber)
+{
+    samplesUntilUpdate = 0;
+
+    // set here rather than in startNote so the flag changes at the event's
+    // sample, not when the event is queued
+    noteReleased = false;
+    outputLevelValid = false;
+
     // reset envelopes
     ampEnvelope.reset();
     filterEnvelope.reset();
@@ -49,39 +120,43 @@ void SynthVoice::startNote(int midiNoteNumber, float velocity, juce::Synthesiser
     
     readParameterState();
 
+    // reset level tracking
+    lastAmpEnvelopeSample = 0.0f;
+    updateOscillatorGainSum();
+    outputLevel = 0.0f;
+
     // reset oscillator phase
     osc1.startNote();
     osc2.startNote();
 
     // calculate the frequency from the midi and the APVST
-    int currentOctave1 = oscTree.getParameterAsValue("OSC_1_OCTAVE").getValue();
-    int currentOctave2 = oscTree.getParameterAsValue("OSC_2_OCTAVE").getValue();
+    int currentOctave1 = juce::roundToInt(oscTree.getRawParameterValue("OSC_1_OCTAVE")->load());
+    int currentOctave2 = juce::roundToInt(oscTree.getRawParameterValue("OSC_2_OCTAVE")->load());
 
-    int currentSemitone1 = oscTree.getParameterAsValue("OSC_1_SEMITONE").getValue();
-    int currentSemitone2 = oscTree.getParameterAsValue("OSC_2_SEMITONE").getValue();
+    int currentSemitone1 = juce::roundToInt(oscTree.getRawParameterValue("OSC_1_SEMITONE")->load());
+    int currentSemitone2 = juce::roundToInt(oscTree.getRawParameterValue("OSC_2_SEMITONE")->load());
 
     // adjust the frequency with value from the fine tune knob
     float fineTune1 = oscTree.getRawParameterValue("OSC_1_FINE_TUNE")->load();
     float fineTune2 = oscTree.getRawParameterValue("OSC_2_FINE_TUNE")->load();
 
-    auto hertz1 = juce::MidiMessage::getMidiNoteInHertz(midiNoteNumber + currentSemitone1);
-    auto hertz2 = juce::MidiMessage::getMidiNoteInHertz(midiNoteNumber + currentSemitone2);
+    // the note's phase increment at the voice rate is precomputed
+    jassert(rates != nullptr);
+    auto increment1 = rates->getNoteIncrement(midiNoteNumber + currentSemitone1);
+    auto increment2 = rates->getNoteIncrement(midiNoteNumber + currentSemitone2);
 
     // cents formula adapted from http://hyperphysics.phy-astr.gsu.edu/hbase/Music/cents.html
     auto pow1 = currentOctave1 + (fineTune1 / 1200);
     auto pow2 = currentOctave2 + (fineTune2 / 1200);
 
-    auto adjustedFreq1 = 2 * pow(2, pow1) * hertz1;
-    auto adjustedFreq2 = 2 * pow(2, pow2) * hertz2;
-
-    osc1.setFrequency(adjustedFreq1);
-    osc2.setFrequency(adjustedFreq2);
+    osc1.setPhaseIncrement(2 * pow(2, pow1) * increment1);
+    osc2.setPhaseIncrement(2 * pow(2, pow2) * increment2);
 }
 
-/* Stops the voice by the owning synthesiser calling this function, which must be overriden*/
-
-void SynthVoice::stopNote(float, bool allowTailOff)
+void SynthVoice::releaseNote()
 {
+    noteReleased = true;
+
     // set envelopes to release stage
     ampEnvelope.noteOff();
     filterEnvelope.noteOff();
@@ -98,98 +173,175 @@ void SynthVoice::stopNote(float, bool allowTailOff)
 */
 void SynthVoice::renderNextBlock(juce::AudioSampleBuffer& outputBuffer, int startSample, int numSamples)
 {
-    // prepare filter
-    float nextFilterEnvSample;
-    float nextFilter2EnvSample;
-    nextFilterEnvSample = filterEnvelope.getNextSample();
-    nextFilter2EnvSample = filter2Envelope.getNextSample();
+    SYMPLE_TRACE_SCOPE("SynthVoice::renderNextBlock");
+
+    // work out which filters are modulated this block. A filter with no
+    // envelope or lfo amount keeps the same cutoff for the whole block, so
+    // its envelope stepping and control rate updates are skipped. Its
+    // envelope is left where it is until the amount is turned up again.
+    readModulationState();
+
+    osc1ModeInt = juce::roundToInt(oscTree.getRawParameterValue("OSC_1_WAVE_TYPE")->load());
+    oscMode = static_cast<OscillatorMode> (osc1ModeInt);
+    osc1.setMode(oscMode);
+
+    osc2ModeInt = juce::roundToInt(oscTree.getRawParameterValue("OSC_2_WAVE_TYPE")->load());
+    oscMode = static_cast<OscillatorMode> (osc2ModeInt);
+    osc2.setMode(oscMode);
+
+    updateOscillatorGainSum();
+
+    // the synthesiser hands over the whole block with the note events of
+    // this voice queued at their sample positions, so only this voice is
+    // split at its own events
+    const int end = startSample + numSamples;
+    int position = startSample;
+    int nextEvent = applyEventsUpTo(position, end);
+
+    while (position < end)
+    {
+        renderSegment(outputBuffer, position, nextEvent - position);
+        position = nextEvent;
+        nextEvent = applyEventsUpTo(position, end);
+    }
+}
+
+/*
+ *  Renders part of a block during which no note events happen
+ */
+void SynthVoice::renderSegment(juce::AudioSampleBuffer& outputBuffer, int startSample, int numSamples)
+{
+    // the control interval carries on across calls, so cutoff updates land
+    // on the same samples whatever size of block the voice is handed. A new
+    // note, or a voice that isn't playing, updates straight away
+    float nextFilterEnvSample = 0.0f;
+    float nextFilter2EnvSample = 0.0f;
+    if (samplesUntilUpdate <= 0 || !ampEnvelope.isActive())
+    {
+        if (filter1EnvelopeActive)
+            nextFilterEnvSample = filterEnvelope.getNextSample();
+        if (filter2EnvelopeActive)
+            nextFilter2EnvSample = filter2Envelope.getNextSample();
 
-    // set filter values
-    setFilter(startSample, nextFilterEnvSample, nextFilter2EnvSample);
+        SYMPLE_PROFILE_STAGE(profiler, ProfileStage::Filters);
+        setFilter(startSample, nextFilterEnvSample, nextFilter2EnvSample);
+        samplesUntilUpdate = paramUpdateRate;
+    }
+    else
+    {
+        // a filter without modulation has no envelope or lfo to wait for,
+        // it picks up cutoff, resonance and mode changes on every call
+        SYMPLE_PROFILE_STAGE(profiler, ProfileStage::Filters);
+        if (!filter1Modulated)
+            setFilter1(startSample, 0.0f);
+        if (!filter2Modulated)
+            setFilter2(startSample, 0.0f);
+    }
 
     if (ampEnvelope.isActive())
     {
-        // clear voice block for processing
-        voice1Block.clear();
-        voice2Block.clear();
+        // the separate passes add into the voice blocks, so clear them first.
+        // the fused kernel overwrites every sample it renders
+        if (!useFusedKernel)
+        {
+            voice1Block.clear();
+            voice2Block.clear();
+        }
         
         // init counters
-        size_t updateCounter = PARAM_UPDATE_RATE;
+        size_t updateCounter = (size_t)samplesUntilUpdate;
         size_t read = startSample;
         
-        // add oscillator 1 sound
-        osc1ModeInt = oscTree.getParameterAsValue("OSC_1_WAVE_TYPE").getValue();
-        oscMode = static_cast<OscillatorMode> (osc1ModeInt);
-        osc1.setMode(oscMode);
-
-        // add oscillator 2 sound
-        osc2ModeInt = oscTree.getParameterAsValue("OSC_2_WAVE_TYPE").getValue();
-        oscMode = static_cast<OscillatorMode> (osc2ModeInt);
-        osc2.setMode(oscMode);
-        
         // process every sample
         while ((int)read < (startSample + numSamples)) {
             auto max = juce::jmin((startSample + numSamples) - (int)read, (int)updateCounter);
             auto subBlock1 = voice1Block.getSubBlock (read, max);
             auto subBlock2 = voice2Block.getSubBlock (read, max);
-     
-            float osc1Gain = oscTree.getRawParameterValue("OSC_1_GAIN")->load();
-            osc1.generate(subBlock1, (int) subBlock1.getNumSamples(), osc1Gain);
-
-            float osc2Gain = oscTree.getRawParameterValue("OSC_2_GAIN")->load();
-            osc2.generate(subBlock2, (int) subBlock2.getNumSamples(), osc2Gain);
-            
-            // add noise osc sound
-            float noiseGain1 = oscTree.getRawParameterValue("NOISE_1_GAIN")->load();
-            float noiseGain2 = oscTree.getRawParameterValue("NOISE_2_GAIN")->load();
-            noiseOsc.generate(subBlock1, (int) subBlock1.getNumSamples(), noiseGain1);
-            noiseOsc.generate(subBlock2, (int) subBlock2.getNumSamples(), noiseGain2);
 
-            // apply envelope
-            applyAmpEnvelope(subBlock1, subBlock2);
+            if (useFusedKernel)
+            {
+                renderFused(subBlock1, subBlock2, max);
+            }
+            else
+            {
+                {
+                    SYMPLE_PROFILE_STAGE(profiler, ProfileStage::Oscillators);
+                    float osc1Gain = oscTree.getRawParameterValue("OSC_1_GAIN")->load();
+                    osc1.generate(subBlock1, (int) subBlock1.getNumSamples(), osc1Gain);
+
+                    float osc2Gain = oscTree.getRawParameterValue("OSC_2_GAIN")->load();
+                    osc2.generate(subBlock2, (int) subBlock2.getNumSamples(), osc2Gain);
+                }
+
+                // add noise osc sound
+                {
+                    SYMPLE_PROFILE_STAGE(profiler, ProfileStage::Noise);
+                    float noiseGain1 = oscTree.getRawParameterValue("NOISE_1_GAIN")->load();
+                    float noiseGain2 = oscTree.getRawParameterValue("NOISE_2_GAIN")->load();
+                    noiseOsc.generate(subBlock1, (int) subBlock1.getNumSamples(), noiseGain1);
+                    noiseOsc.generate(subBlock2, (int) subBlock2.getNumSamples(), noiseGain2);
+                }
+
+                // apply envelope
+                {
+                    SYMPLE_PROFILE_STAGE(profiler, ProfileStage::Envelopes);
+                    applyAmpEnvelope(subBlock1, subBlock2);
+                }
+
+                // filter sound
+                {
+                    SYMPLE_PROFILE_STAGE(profiler, ProfileStage::Filters);
+                    filter1.process(juce::dsp::ProcessContextReplacing<float>(subBlock1));
+                    filter2.process(juce::dsp::ProcessContextReplacing<float>(subBlock2));
+                }
+            }
 
-            // filter sound
-            filter1.process(juce::dsp::ProcessContextReplacing<float>(subBlock1));
-            filter2.process(juce::dsp::ProcessContextReplacing<float>(subBlock2));
+            // stop rendering once a released voice can no longer be heard,
+            // the rest of the voice blocks stay cleared
+            outputLevel = lastAmpEnvelopeSample * oscillatorGainSum;
 
             // set counters
             read += max;
             updateCounter -= max;
 
-            // advance the filter envelope for the amount of processed samples
+            if (noteReleased && outputLevel < silenceThreshold)
+                break;
+
+            // advance the filter envelopes for the amount of processed samples
             // and keep the most recent setting
-            while (max-- > 1)
             {
-                filterEnvelope.getNextSample();
-                filter2Envelope.getNextSample();
+                SYMPLE_PROFILE_STAGE(profiler, ProfileStage::Envelopes);
+                if (filter1EnvelopeActive)
+                    nextFilterEnvSample = advanceEnvelope(filterEnvelope, max);
+                if (filter2EnvelopeActive)
+                    nextFilter2EnvSample = advanceEnvelope(filter2Envelope, max);
             }
-            
-            nextFilterEnvSample = filterEnvelope.getNextSample();
-            nextFilter2EnvSample = filter2Envelope.getNextSample();
 
             if (updateCounter == 0)
             {
+                SYMPLE_PROFILE_STAGE(profiler, ProfileStage::Filters);
+
                 // reset the amount of samples to process
-                updateCounter = PARAM_UPDATE_RATE;
+                updateCounter = paramUpdateRate;
 
-                // update filter
                 setFilter(read, nextFilterEnvSample, nextFilter2EnvSample);
             }
             
         }
 
-        // add voice output to main buffer
-        juce::dsp::AudioBlock<float> output(outputBuffer);
-        output.add(voice1Block);
-        output.add(voice2Block);
+        samplesUntilUpdate = (int)updateCounter;
+        outputLevelValid = true;
+
+        // add the rendered part of the voice output to main buffer
+        auto numRendered = (size_t)read - (size_t)startSample;
+        auto output = juce::dsp::AudioBlock<float>(outputBuffer).getSubBlock((size_t)startSample, numRendered);
+        output.add(voice1Block.getSubBlock((size_t)startSample, numRendered));
+        output.add(voice2Block.getSubBlock((size_t)startSample, numRendered));
         
-        // reset amp envelope if it's finished
-        if (!ampEnvelope.isActive()) {
-            ampEnvelope.reset();
-            filterEnvelope.reset();
-            filter2Envelope.reset();
-            clearCurrentNote();
-        }
+        // free the voice if the amp envelope is finished or the release
+        // tail has dropped below the silence threshold
+        if (!ampEnvelope.isActive() || (noteReleased && outputLevel < silenceThreshold))
+            endNote();
     }
     else
     {
@@ -203,8 +355,65 @@ void SynthVoice::prepare(const juce::dsp::ProcessSpec& spec)
 {
     voice1Block = juce::dsp::AudioBlock<float> (heap1Block, spec.numChannels, spec.maximumBlockSize);
     voice2Block = juce::dsp::AudioBlock<float> (heap2Block, spec.numChannels, spec.maximumBlockSize);
-    filter1.prepare(spec);
-    filter2.prepare(spec);
+    ampEnvelopeBuffer.allocate(spec.maximumBlockSize, true);
+    numPendingEvents = 0;
+    voiceSpec = spec; // the rates follow with setRenderQuality
+    filterRate = 0.0;
+}
+
+void SynthVoice::setRenderQuality(const RenderQualitySettings& settings, const VoiceRates& voiceRates)
+{
+    quality = settings;
+    rates = &voiceRates;
+    updateParamUpdateRate();
+
+    const double sampleRate = voiceRates.sampleRate;
+
+    osc1.setBandLimited(settings.bandLimited);
+    osc2.setBandLimited(settings.bandLimited);
+
+    osc1.setSampleRate(sampleRate);
+    osc2.setSampleRate(sampleRate);
+    noiseOsc.setSampleRate(sampleRate);
+    ampEnvelope.setSampleRate(sampleRate);
+    filterEnvelope.setSampleRate(sampleRate);
+    filter2Envelope.setSampleRate(sampleRate);
+
+    filter1.setSmoothingTime(voiceRates.filterSmoothingTime);
+    filter2.setSmoothingTime(voiceRates.filterSmoothingTime);
+
+    // preparing the filters clears them, so that only happens for a new rate.
+    // A tier at the same rate keeps the notes that are sounding
+    voiceSpec.sampleRate = sampleRate;
+    if (voiceSpec.numChannels > 0 && sampleRate != filterRate)
+    {
+        filter1.prepare(voiceSpec);
+        filter2.prepare(voiceSpec);
+        filterRate = sampleRate;
+    }
+}
+
+void SynthVoice::setControlRateScale(int scale)
+{
+    controlRateScale = juce::jmax(1, scale);
+    updateParamUpdateRate();
+}
+
+void SynthVoice::updateParamUpdateRate()
+{
+    const int tierUpdateRate = rates != nullptr ? rates->controlInterval : RateContextConstants::paramUpdateRate;
+    paramUpdateRate = tierUpdateRate * controlRateScale;
+    samplesUntilUpdate = juce::jmin(samplesUntilUpdate, paramUpdateRate);
+}
+
+void SynthVoice::setFusedRendering(bool shouldUseFusedKernel)
+{
+    useFusedKernel = shouldUseFusedKernel;
+}
+
+void SynthVoice::setSilenceThreshold(float decibels)
+{
+    silenceThreshold = juce::Decibels::decibelsToGain(decibels);
 }
 
 /*
@@ -243,7 +452,7 @@ void SynthVoice::readParameterState()
  */
 void SynthVoice::applyAmpEnvelope(juce::dsp::AudioBlock<float>& subBlock1, juce::dsp::AudioBlock<float>& subBlock2)
 {
-    float env;
+    float env = lastAmpEnvelopeSample;
     for (int sample = 0; sample < subBlock1.getNumSamples(); ++sample)
     {
         env = ampEnvelope.getNextSample();
@@ -253,12 +462,122 @@ void SynthVoice::applyAmpEnvelope(juce::dsp::AudioBlock<float>& subBlock1, juce:
             subBlock2.setSample(channel, sample, subBlock2.getSample(channel, sample) * env);
         }
     }
+    lastAmpEnvelopeSample = env;
+}
+
+/*
+ *  Renders both signal paths of the voice with the fused kernels. The amp
+ *  envelope is computed once for the sub block and shared by both paths.
+ */
+void SynthVoice::renderFused(juce::dsp::AudioBlock<float>& subBlock1, juce::dsp::AudioBlock<float>& subBlock2, int numSamples)
+{
+    {
+        SYMPLE_PROFILE_STAGE(profiler, ProfileStage::Envelopes);
+        for (int sample = 0; sample < numSamples; ++sample)
+            ampEnvelopeBuffer[sample] = ampEnvelope.getNextSample();
+        lastAmpEnvelopeSample = ampEnvelopeBuffer[numSamples - 1];
+    }
+
+    FusedVoicePath path1 { osc1, noiseOsc, filter1,
+                           juce::Decibels::decibelsToGain((double)oscTree.getRawParameterValue("OSC_1_GAIN")->load()),
+                           juce::Decibels::decibelsToGain((double)oscTree.getRawParameterValue("NOISE_1_GAIN")->load()) };
+    FusedVoicePath path2 { osc2, noiseOsc, filter2,
+                           juce::Decibels::decibelsToGain((double)oscTree.getRawParameterValue("OSC_2_GAIN")->load()),
+                           juce::Decibels::decibelsToGain((double)oscTree.getRawParameterValue("NOISE_2_GAIN")->load()) };
+
+    auto kernel1 = getFusedVoiceKernel(osc1.getMode(), path1.noiseGain > 0.0, filter1.getMode(), filter1.isSmoothing());
+    auto kernel2 = getFusedVoiceKernel(osc2.getMode(), path2.noiseGain > 0.0, filter2.getMode(), filter2.isSmoothing());
+
+    SYMPLE_PROFILE_STAGE(profiler, ProfileStage::VoiceKernel);
+    kernel1(path1, ampEnvelopeBuffer, subBlock1, numSamples);
+    kernel2(path2, ampEnvelopeBuffer, subBlock2, numSamples);
+}
+
+/*
+ *  Sums the linear gains of every oscillator feeding the voice. Multiplied by
+ *  the amp envelope this gives a cheap upper bound of the voice output level
+ */
+void SynthVoice::updateOscillatorGainSum()
+{
+    oscillatorGainSum = juce::Decibels::decibelsToGain(oscTree.getRawParameterValue("OSC_1_GAIN")->load())
+                      + juce::Decibels::decibelsToGain(oscTree.getRawParameterValue("OSC_2_GAIN")->load())
+                      + juce::Decibels::decibelsToGain(oscTree.getRawParameterValue("NOISE_1_GAIN")->load())
+                      + juce::Decibels::decibelsToGain(oscTree.getRawParameterValue("NOISE_2_GAIN")->load());
+}
+
+/*
+ *  Silences the voice without touching the synthesiser's note bookkeeping
+ */
+void SynthVoice::resetNote()
+{
+    ampEnvelope.reset();
+    filterEnvelope.reset();
+    filter2Envelope.reset();
+    outputLevel = 0.0f;
+    lastAmpEnvelopeSample = 0.0f;
+}
+
+/* False while a queued note start hasn't been rendered yet */
+bool SynthVoice::hasOutputLevel() const
+{
+    for (int i = 0; i < numPendingEvents; ++i)
+        if (pendingEvents[(size_t)i].type == EVENT_START)
+            return false;
+
+    return outputLevelValid;
+}
+
+/*
+ *  Resets the envelopes and hands the voice back to the synthesiser. If a
+ *  new note is already queued for later in the block the synthesiser has
+ *  given the voice to that note, so it must not be cleared.
+ */
+void SynthVoice::endNote()
+{
+    resetNote();
+
+    for (int i = 0; i < numPendingEvents; ++i)
+        if (pendingEvents[(size_t)i].type == EVENT_START)
+            return;
+
+    clearCurrentNote();
+}
+
+/*
+ *  Reads the envelope and lfo amounts and works out which filters
+ *  have a cutoff that can move during this block
+ */
+void SynthVoice::readModulationState()
+{
+    lfoAmount = oscTree.getRawParameterValue("LFO_AMOUNT")->load();
+    filter1EnvelopeActive = oscTree.getRawParameterValue("FILTER_1_AMOUNT")->load() > 0.0f;
+    filter2EnvelopeActive = oscTree.getRawParameterValue("FILTER_2_AMOUNT")->load() > 0.0f;
+    filter1Modulated = filter1EnvelopeActive || lfoAmount > 0.0f;
+    filter2Modulated = filter2EnvelopeActive || lfoAmount > 0.0f;
+}
+
+/*
+ *  Steps an envelope forward by numSamples and returns the last sample
+ */
+float SynthVoice::advanceEnvelope(juce::ADSR& envelope, int numSamples)
+{
+    while (numSamples-- > 1)
+        envelope.getNextSample();
+
+    return envelope.getNextSample();
 }
 
 /*
  *  Updates the filter settings with changes from the UI and LFO
  */
 void SynthVoice::setFilter(size_t read, float filterEnv, float filter2EnvSample)
+{
+    SYMPLE_TRACE_SCOPE("SynthVoice::setFilter");
+    setFilter1(read, filterEnv);
+    setFilter2(read, filter2EnvSample);
+}
+
+void SynthVoice::setFilter1(size_t read, float filterEnv)
 {
     freq = oscTree.getRawParameterValue("FILTER_1_CUTOFF")->load();
     res = oscTree.getRawParameterValue("FILTER_1_RESONANCE")->load() / 100;
@@ -279,24 +598,29 @@ void SynthVoice::setFilter(size_t read, float filterEnv, float filter2EnvSample)
 
 
     // set the filter 1 values
-    filterModeInt = oscTree.getParameterAsValue("FILTER_1_MODE").getValue();
+    filterModeInt = juce::roundToInt(oscTree.getRawParameterValue("FILTER_1_MODE")->load());
     filterMode = static_cast<FilterMode> (filterModeInt);
     filter1.setMode(filterMode);
     filter1.setCutoffFrequencyHz(juce::jmax(cutOffFreqHz, lfoCutoffFreqHz));
     filter1.setResonance(res);
+}
 
-    // SET FILTER 2
+void SynthVoice::setFilter2(size_t read, float filter2EnvSample)
+{
     freq = oscTree.getRawParameterValue("FILTER_2_CUTOFF")->load();
     res = oscTree.getRawParameterValue("FILTER_2_RESONANCE")->load() / 100;
     amount = oscTree.getRawParameterValue("FILTER_2_AMOUNT")->load();
-    
+    lfoAmount = oscTree.getRawParameterValue("LFO_AMOUNT")->load();
+
+    lfoSample = (int)juce::jmax((int)read - 1, (int)0);
+
     freqMax = juce::jmin((float)(freq * pow(twelfthRoot, amount)), 20000.0f);
     lfoFreqMax = juce::jmin((float)(freq * pow(twelfthRoot, lfoAmount)), 20000.0f);
-    cutOffFreqHz = juce::jmap(filter2EnvSample, 0.0f, 1.0f, freq, freqMax);
+    auto cutOffFreqHz = juce::jmap(filter2EnvSample, 0.0f, 1.0f, freq, freqMax);
     lfoCutoffFreqHz = juce::jmap(lfoBuffer.getSample(0, lfoSample), -1.0f, 1.0f, freq, lfoFreqMax);
     
     // set filter 2 values
-    filterModeInt = oscTree.getParameterAsValue("FILTER_2_MODE").getValue();
+    filterModeInt = juce::roundToInt(oscTree.getRawParameterValue("FILTER_2_MODE")->load());
     filterMode = static_cast<FilterMode> (filterModeInt);
     filter2.setMode(filterMode);
     filter2.setCutoffFrequencyHz(juce::jmax(cutOffFreqHz, lfoCutoffFreqHz));
@@ -308,6 +632,9 @@ void SynthVoice::setFilter(size_t read, float filterEnv, float filter2EnvSample)
  */
 void SynthVoice::runSmoothers(int numSamples)
 {
+    if (!filter1.isSmoothing() && !filter2.isSmoothing())
+        return;
+
     for (int i = 0; i < numSamples; ++i)
     {
         filter1.updateSmoothers();
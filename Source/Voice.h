@@ -13,6 +13,11 @@
 #include <JuceHeader.h>
 #include "Osc.h"
 #include "Filter.h"
+#include "VoiceKernel.h"
+#include "Profiler.h"
+#include "TraceRecorder.h"
+#include "RenderQuality.h"
+#include "RateContext.h"
 
 /*
 Describes one of the sounds that a Synthesiser can play.
@@ -36,7 +41,7 @@ struct SynthSound : public juce::SynthesiserSound
 A voice plays a single sound at a time, and a synthesiser holds an array of voices so that it can play polyphonically. The Synthesiser controls the voices */
 struct SynthVoice : public juce::SynthesiserVoice
 {
-    SynthVoice(juce::AudioProcessorValueTreeState&, juce::dsp::AudioBlock<float>&);
+    SynthVoice(juce::AudioProcessorValueTreeState&, juce::dsp::AudioBlock<float>&, const int& eventSample);
 
     bool canPlaySound(juce::SynthesiserSound* sound) override;
 
@@ -52,9 +57,44 @@ struct SynthVoice : public juce::SynthesiserVoice
     /* Renders the next block of data for this voice. */
     void renderNextBlock(juce::AudioSampleBuffer& outputBuffer, int startSample, int numSamples) override;
     
-    /* sets buffer and sample rate for juce dsp */
+    /* allocates the voice buffers, call setRenderQuality afterwards for the rates */
     void prepare(const juce::dsp::ProcessSpec& spec);
 
+    /* Applies a quality tier and its rates from the current RateContext,
+       which must outlive the voice. Doesn't allocate, but the blocks from
+       prepare must be large enough for the oversampled block */
+    void setRenderQuality(const RenderQualitySettings& settings, const VoiceRates& voiceRates);
+
+    /* Multiplies the control interval on top of the quality tier, used by the
+       CPU governor to trade modulation resolution for time */
+    void setControlRateScale(int scale);
+
+    /* Sets the level (in dB) below which a released voice is considered silent
+       and is freed before its release stage finishes */
+    void setSilenceThreshold(float decibels);
+
+    /* Estimated output level of the voice (linear gain), taken from the amp
+       envelope and the oscillator gains at the end of the last rendered block */
+    float getOutputLevel() const { return outputLevel; }
+
+    /* False from a note start until some of the note has been rendered, while
+       getOutputLevel() still says nothing about it */
+    bool hasOutputLevel() const;
+
+    /* True from the synthesiser's note off, which may not have been reached by
+       rendering yet, until the next note start */
+    bool hasReceivedNoteOff() const { return noteOffReceived; }
+
+    /* True once rendering has reached the voice's note off and it is in its release tail */
+    bool isReleasing() const { return noteReleased; }
+
+    /* Switches between the fused per-sample kernel and the separate
+       oscillator, envelope and filter passes */
+    void setFusedRendering(bool shouldUseFusedKernel);
+
+    /* Where the voice adds its per stage cycle counts, see Profiler.h */
+    void setProfiler(Profiler* newProfiler) { profiler = newProfiler; }
+
 private:
     float freq;
     float res;
@@ -69,7 +109,28 @@ private:
     double twelfthRoot = pow(2.0, 1.0 / 12.0);
     juce::String maxString = "max: ";
     juce::String readString = "read: ";
-    const int PARAM_UPDATE_RATE = 100; // the number of samples each parameter setting will process
+    int paramUpdateRate = RateContextConstants::paramUpdateRate; // the tier's control interval scaled by the governor
+    int controlRateScale = 1;
+    int samplesUntilUpdate = 0; // of the control interval, kept between blocks
+    RenderQualitySettings quality = RenderQualityTiers::getSettings(RenderQuality::Normal);
+    const VoiceRates* rates = nullptr; // set with the quality tier, before the first note
+    juce::dsp::ProcessSpec voiceSpec {};
+    double filterRate = 0.0; // the filters were last prepared at this rate, 0 until they are
+
+    // voice level tracking for early release termination
+    float outputLevel = 0.0f;
+    float lastAmpEnvelopeSample = 0.0f;
+    float oscillatorGainSum = 0.0f;
+    float silenceThreshold = juce::Decibels::decibelsToGain(-100.0f);
+    bool noteReleased = false;
+    bool noteOffReceived = false;
+    bool outputLevelValid = false;
+
+    // per block modulation state, unmodulated filters keep a constant cutoff
+    bool filter1EnvelopeActive = true;
+    bool filter2EnvelopeActive = true;
+    bool filter1Modulated = true;
+    bool filter2Modulated = true;
 
     // memory for voice processing
     juce::HeapBlock<char> heap1Block;
@@ -77,6 +138,9 @@ private:
     juce::dsp::AudioBlock<float> voice1Block;
     juce::dsp::AudioBlock<float> voice2Block;
     juce::dsp::AudioBlock<float>& lfoBuffer;
+    juce::HeapBlock<float> ampEnvelopeBuffer;
+    bool useFusedKernel = true;
+    Profiler* profiler = nullptr;
 
     juce::ADSR ampEnvelope;
     FilterMode filterMode;
@@ -87,6 +151,19 @@ private:
     juce::ADSR::Parameters filterEnvelopeParameters;
     juce::ADSR::Parameters filter2EnvelopeParameters;
     juce::AudioProcessorValueTreeState& oscTree;
+
+    // note events waiting for rendering to reach their sample position
+    enum PendingEventType { EVENT_START, EVENT_RELEASE, EVENT_KILL };
+    struct PendingEvent
+    {
+        int sample;
+        PendingEventType type;
+        int midiNoteNumber;
+    };
+    const int& eventSample; // sample of the midi event the synthesiser is handling
+    std::array<PendingEvent, 32> pendingEvents;
+    int numPendingEvents = 0;
+
     Oscillator osc1;
     Oscillator osc2;
     Oscillator noiseOsc;
@@ -95,8 +172,23 @@ private:
     Filter<float> filter2;
     OscillatorMode oscMode;
 
+    void queueEvent(const PendingEvent&);
+    int applyEventsUpTo(int sample, int end);
+    void applyEvent(const PendingEvent&);
+    void beginNote(int midiNoteNumber);
+    void releaseNote();
+    void resetNote();
+    void renderSegment(juce::AudioSampleBuffer&, int startSample, int numSamples);
     void readParameterState();
+    void renderFused(juce::dsp::AudioBlock<float>&, juce::dsp::AudioBlock<float>&, int);
     void applyAmpEnvelope(juce::dsp::AudioBlock<float>&, juce::dsp::AudioBlock<float>&);
+    void readModulationState();
+    float advanceEnvelope(juce::ADSR&, int);
     void setFilter(size_t, float, float);
+    void setFilter1(size_t, float);
+    void setFilter2(size_t, float);
     void runSmoothers(int);
+    void updateOscillatorGainSum();
+    void updateParamUpdateRate();
+    void endNote();
 };
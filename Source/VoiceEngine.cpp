@@ -0,0 +1,635 @@
+/*
+  ==============================================================================
+
+    VoiceEngine.cpp
+    Created: 19 Oct 2026
+    Author:  woz
+
+  ==============================================================================
+*/
+
+#include "VoiceEngine.h"
+
+VoiceEngine::VoiceEngine(juce::AudioProcessorValueTreeState& t) : tree(t)
+{
+    kernels = &LaneKernels::getTable(maximumSimdLevel);
+
+    // same drive setup as the default Filter
+    drive = 1.2f;
+    driveGain = std::pow(drive, -2.642f) * 0.6103f + 0.3903f;
+    drive2 = drive * 0.04f + 0.96f;
+    driveGain2 = std::pow(drive2, -2.642f) * 0.6103f + 0.3903f;
+
+    allNotesOff();
+}
+
+void VoiceEngine::prepare(const juce::dsp::ProcessSpec& spec)
+{
+    sampleRate = spec.sampleRate;
+    cutoffFreqScaler = (float)(-2.0 * juce::MathConstants<double>::pi / sampleRate);
+    kernels = &LaneKernels::getTable(maximumSimdLevel);
+    allNotesOff();
+}
+
+void VoiceEngine::setPolyphony(int numVoices)
+{
+    polyphony = juce::jlimit(1, maxVoices, numVoices);
+}
+
+void VoiceEngine::setSilenceThreshold(float decibels)
+{
+    silenceThreshold = juce::Decibels::decibelsToGain(decibels);
+}
+
+/*
+ *  Clears every lane. Unused lanes are still run by the stage loops so
+ *  they must always hold finite values.
+ */
+void VoiceEngine::allNotesOff()
+{
+    numActive = 0;
+    std::memset(note, 0, sizeof(note));
+    std::memset(channel, 0, sizeof(channel));
+    std::memset(released, 0, sizeof(released));
+    std::memset(keyDown, 0, sizeof(keyDown));
+    std::memset(sustainHeld, 0, sizeof(sustainHeld));
+    std::memset(sostenutoHeld, 0, sizeof(sostenutoHeld));
+    std::memset(sustainPedalDown, 0, sizeof(sustainPedalDown));
+    std::memset(age, 0, sizeof(age));
+    std::memset(noiseState, 0, sizeof(noiseState));
+    std::memset(&osc1, 0, sizeof(osc1));
+    std::memset(&osc2, 0, sizeof(osc2));
+    std::memset(&ampEnvelope, 0, sizeof(ampEnvelope));
+    std::memset(&filter1Envelope, 0, sizeof(filter1Envelope));
+    std::memset(&filter2Envelope, 0, sizeof(filter2Envelope));
+    std::memset(&filter1, 0, sizeof(filter1));
+    std::memset(&filter2, 0, sizeof(filter2));
+}
+
+void VoiceEngine::renderNextBlock(juce::AudioBuffer<float>& outputBuffer, const juce::MidiBuffer& midi,
+                                  const juce::dsp::AudioBlock<float>& lfoBuffer, int startSample, int numSamples)
+{
+    readParameters();
+    releaseLanesOverLimit();
+
+    const int end = startSample + numSamples;
+    int position = startSample;
+
+    // render up to each event, then let it change the lanes
+    for (const auto metadata : midi)
+    {
+        const int eventPosition = juce::jlimit(startSample, end, metadata.samplePosition);
+        renderRange(outputBuffer, lfoBuffer, position, eventPosition - position);
+        position = eventPosition;
+        handleMidiEvent(metadata.getMessage());
+    }
+
+    renderRange(outputBuffer, lfoBuffer, position, end - position);
+}
+
+void VoiceEngine::renderRange(juce::AudioBuffer<float>& outputBuffer, const juce::dsp::AudioBlock<float>& lfoBuffer,
+                              int startSample, int numSamples)
+{
+    alignas(32) float mono[subBlockSize];
+    const int lastLfoSample = juce::jmax(0, (int)lfoBuffer.getNumSamples() - 1);
+
+    while (numSamples > 0 && numActive > 0)
+    {
+        const int count = juce::jmin(numSamples, subBlockSize);
+
+        juce::FloatVectorOperations::clear(mono, count);
+        renderSubBlock(mono, lfoBuffer, juce::jmin(startSample, lastLfoSample), count);
+
+        for (int channel = 0; channel < outputBuffer.getNumChannels(); ++channel)
+            juce::FloatVectorOperations::add(outputBuffer.getWritePointer(channel, startSample), mono, count);
+
+        startSample += count;
+        numSamples -= count;
+    }
+}
+
+/*
+ *  Runs each stage over a block of lanes before moving to the next one
+ */
+void VoiceEngine::renderSubBlock(float* output, const juce::dsp::AudioBlock<float>& lfoBuffer, int lfoSample, int numSamples)
+{
+    const float lfoValue = lfoBuffer.getSample(0, lfoSample);
+
+    for (int first = 0; first < numActive; first += laneBlockSize)
+    {
+        updateFilterCoefficients(filter1, filter1Envelope, params.cutoff1, params.amount1, lfoValue, first);
+        updateFilterCoefficients(filter2, filter2Envelope, params.cutoff2, params.amount2, lfoValue, first);
+
+        renderOscillatorLanes(params.osc1Mode, osc1, first, numSamples, params.osc1Gain, path1);
+        renderOscillatorLanes(params.osc2Mode, osc2, first, numSamples, params.osc2Gain, path2);
+
+        if (params.noise1Gain > 0.0f)
+            kernels->noise(noiseState + first, numSamples, params.noise1Gain, path1);
+        if (params.noise2Gain > 0.0f)
+            kernels->noise(noiseState + first, numSamples, params.noise2Gain, path2);
+
+        renderEnvelopeLanes(ampEnvelope, params.amp, first, numSamples, envelope);
+        kernels->applyEnvelope(path1, path2, envelope, numSamples);
+
+        renderFilterLanes(filter1, params.mix1, params.resonance1, first, numSamples, path1);
+        renderFilterLanes(filter2, params.mix2, params.resonance2, first, numSamples, path2);
+
+        // unmodulated filter envelopes are left where they are
+        if (params.amount1 > 0.0f)
+            advanceEnvelopeLanes(filter1Envelope, params.filter1, first, numSamples);
+        if (params.amount2 > 0.0f)
+            advanceEnvelopeLanes(filter2Envelope, params.filter2, first, numSamples);
+
+        // mix down the lanes that are playing
+        kernels->mix(path1, path2, juce::jmin(laneBlockSize, numActive - first), numSamples, output);
+    }
+
+    freeSilentVoices();
+}
+
+//==============================================================================
+void VoiceEngine::renderOscillatorLanes(OscillatorMode mode, OscillatorLanes& o, int first, int numSamples, float gain, float (*out)[laneBlockSize])
+{
+    jassert((int)mode >= 0 && (int)mode < LaneKernels::numOscillatorModes);
+    kernels->oscillator[mode](o.phase + first, o.increment + first, o.lastOutput + first, numSamples, gain, out);
+}
+
+//==============================================================================
+void VoiceEngine::renderEnvelopeLanes(EnvelopeLanes& env, const EnvelopeRates& rates, int first, int numSamples, float (*out)[laneBlockSize])
+{
+    for (int lane = 0; lane < laneBlockSize; ++lane)
+    {
+        const int i = first + lane;
+        float level = env.level[i];
+        int stage = env.stage[i];
+
+        for (int sample = 0; sample < numSamples; ++sample)
+        {
+            switch (stage)
+            {
+            case ENV_ATTACK:
+                level += rates.attack;
+                if (level >= 1.0f)
+                {
+                    level = 1.0f;
+                    stage = rates.decay > 0.0f ? ENV_DECAY : ENV_SUSTAIN;
+                }
+                break;
+            case ENV_DECAY:
+                level -= rates.decay;
+                if (level <= rates.sustain)
+                {
+                    level = rates.sustain;
+                    stage = ENV_SUSTAIN;
+                }
+                break;
+            case ENV_SUSTAIN:
+                level = rates.sustain;
+                break;
+            case ENV_RELEASE:
+                level -= env.releaseRate[i];
+                if (level <= 0.0f)
+                {
+                    level = 0.0f;
+                    stage = ENV_IDLE;
+                }
+                break;
+            default:
+                level = 0.0f;
+                break;
+            }
+
+            out[sample][lane] = level;
+        }
+
+        env.level[i] = level;
+        env.stage[i] = stage;
+    }
+}
+
+void VoiceEngine::advanceEnvelopeLanes(EnvelopeLanes& env, const EnvelopeRates& rates, int first, int numSamples)
+{
+    // the scratch envelope buffer is free again once the amp envelope is applied
+    renderEnvelopeLanes(env, rates, first, numSamples, envelope);
+}
+
+void VoiceEngine::startEnvelope(EnvelopeLanes& env, const EnvelopeRates& rates, int lane)
+{
+    env.level[lane] = 0.0f;
+    env.releaseRate[lane] = 0.0f;
+
+    if (rates.attack > 0.0f)
+    {
+        env.stage[lane] = ENV_ATTACK;
+    }
+    else if (rates.decay > 0.0f)
+    {
+        env.level[lane] = 1.0f;
+        env.stage[lane] = ENV_DECAY;
+    }
+    else
+    {
+        env.stage[lane] = ENV_SUSTAIN;
+    }
+}
+
+void VoiceEngine::releaseEnvelope(EnvelopeLanes& env, const EnvelopeRates& rates, int lane)
+{
+    if (env.stage[lane] == ENV_IDLE)
+        return;
+
+    if (rates.release > 0.0f)
+    {
+        env.releaseRate[lane] = env.level[lane] / (rates.release * (float)sampleRate);
+        env.stage[lane] = ENV_RELEASE;
+    }
+    else
+    {
+        env.level[lane] = 0.0f;
+        env.stage[lane] = ENV_IDLE;
+    }
+}
+
+//==============================================================================
+void VoiceEngine::updateFilterCoefficients(FilterLanes& f, const EnvelopeLanes& env, float cutoff, float amount, float lfoValue, int first)
+{
+    // same cutoff mapping as SynthVoice::setFilter
+    const float freqMax = juce::jmin(cutoff * std::pow(2.0f, amount / 12.0f), 20000.0f);
+    const float lfoFreqMax = juce::jmin(cutoff * std::pow(2.0f, params.lfoAmount / 12.0f), 20000.0f);
+    const float lfoCutoff = juce::jmap(lfoValue, -1.0f, 1.0f, cutoff, lfoFreqMax);
+
+    for (int lane = 0; lane < laneBlockSize; ++lane)
+    {
+        const int i = first + lane;
+        const float envelopeCutoff = cutoff + env.level[i] * (freqMax - cutoff);
+        const float a1 = std::exp(std::max(envelopeCutoff, lfoCutoff) * cutoffFreqScaler);
+        const float g = 1.0f - a1;
+
+        f.a1[i] = a1;
+        f.b0[i] = g * 0.76923076923f;
+        f.b1[i] = g * 0.23076923076f;
+    }
+}
+
+void VoiceEngine::renderFilterLanes(FilterLanes& f, const FilterMix& mix, float resonance, int first, int numSamples, float (*io)[laneBlockSize])
+{
+    LaneKernels::FilterArgs args;
+
+    for (int i = 0; i < 5; ++i)
+    {
+        args.s[i] = f.s[i] + first;
+        args.mix[i] = mix.a[(size_t)i];
+    }
+
+    args.a1 = f.a1 + first;
+    args.b0 = f.b0 + first;
+    args.b1 = f.b1 + first;
+    args.comp = mix.comp;
+    args.scaledResonance = 0.1f + resonance * 0.9f;
+    args.drive = drive;
+    args.driveGain = driveGain;
+    args.drive2 = drive2;
+    args.driveGain2 = driveGain2;
+
+    kernels->filter(args, numSamples, io);
+}
+
+VoiceEngine::FilterMix VoiceEngine::filterMix(FilterMode mode)
+{
+    FilterMix mix;
+
+    switch (mode)
+    {
+        case FilterMode::LPF12:   mix = { {{ 0.0f, 0.0f,  1.0f, 0.0f,  0.0f }}, 0.5f }; break;
+        case FilterMode::HPF12:   mix = { {{ 1.0f, -2.0f, 1.0f, 0.0f,  0.0f }}, 0.0f }; break;
+        case FilterMode::BPF12:   mix = { {{ 0.0f, 0.0f, -1.0f, 1.0f,  0.0f }}, 0.5f }; break;
+        case FilterMode::LPF24:   mix = { {{ 0.0f, 0.0f,  0.0f, 0.0f,  1.0f }}, 0.5f }; break;
+        case FilterMode::HPF24:   mix = { {{ 1.0f, -4.0f, 6.0f, -4.0f, 1.0f }}, 0.0f }; break;
+        case FilterMode::BPF24:   mix = { {{ 0.0f, 0.0f,  1.0f, -2.0f, 1.0f }}, 0.5f }; break;
+        default:                  jassertfalse; mix = { {{ 0.0f, 0.0f, 0.0f, 0.0f, 0.0f }}, 0.0f }; break;
+    }
+
+    for (auto& a : mix.a)
+        a *= 1.2f;
+
+    return mix;
+}
+
+//==============================================================================
+void VoiceEngine::readParameters()
+{
+    params.osc1Mode = static_cast<OscillatorMode> ((int)tree.getRawParameterValue("OSC_1_WAVE_TYPE")->load());
+    params.osc2Mode = static_cast<OscillatorMode> ((int)tree.getRawParameterValue("OSC_2_WAVE_TYPE")->load());
+    params.osc1Gain = juce::Decibels::decibelsToGain(tree.getRawParameterValue("OSC_1_GAIN")->load());
+    params.osc2Gain = juce::Decibels::decibelsToGain(tree.getRawParameterValue("OSC_2_GAIN")->load());
+    params.noise1Gain = juce::Decibels::decibelsToGain(tree.getRawParameterValue("NOISE_1_GAIN")->load());
+    params.noise2Gain = juce::Decibels::decibelsToGain(tree.getRawParameterValue("NOISE_2_GAIN")->load());
+
+    params.cutoff1 = tree.getRawParameterValue("FILTER_1_CUTOFF")->load();
+    params.cutoff2 = tree.getRawParameterValue("FILTER_2_CUTOFF")->load();
+    params.resonance1 = tree.getRawParameterValue("FILTER_1_RESONANCE")->load() / 100;
+    params.resonance2 = tree.getRawParameterValue("FILTER_2_RESONANCE")->load() / 100;
+    params.amount1 = tree.getRawParameterValue("FILTER_1_AMOUNT")->load();
+    params.amount2 = tree.getRawParameterValue("FILTER_2_AMOUNT")->load();
+    params.lfoAmount = tree.getRawParameterValue("LFO_AMOUNT")->load();
+    params.mix1 = filterMix(static_cast<FilterMode> ((int)tree.getRawParameterValue("FILTER_1_MODE")->load()));
+    params.mix2 = filterMix(static_cast<FilterMode> ((int)tree.getRawParameterValue("FILTER_2_MODE")->load()));
+
+    params.amp = readEnvelopeRates("AMP_ATTACK", "AMP_DECAY", "AMP_SUSTAIN", "AMP_RELEASE");
+    params.filter1 = readEnvelopeRates("FILTER_1_ATTACK", "FILTER_1_DECAY", "FILTER_1_SUSTAIN", "FILTER_1_RELEASE");
+    params.filter2 = readEnvelopeRates("FILTER_2_ATTACK", "FILTER_2_DECAY", "FILTER_2_SUSTAIN", "FILTER_2_RELEASE");
+}
+
+/*
+ *  Per sample rates worked out the same way as juce::ADSR::recalculateRates
+ */
+VoiceEngine::EnvelopeRates VoiceEngine::readEnvelopeRates(const char* attack, const char* decay, const char* sustain, const char* release) const
+{
+    const float attackTime = tree.getRawParameterValue(attack)->load();
+    const float decayTime = tree.getRawParameterValue(decay)->load();
+    const float sustainLevel = tree.getRawParameterValue(sustain)->load() / 100;
+    const float sr = (float)sampleRate;
+
+    EnvelopeRates rates;
+    rates.attack = attackTime > 0.0f ? 1.0f / (attackTime * sr) : -1.0f;
+    rates.decay = decayTime > 0.0f ? (1.0f - sustainLevel) / (decayTime * sr) : -1.0f;
+    rates.sustain = sustainLevel;
+    rates.release = tree.getRawParameterValue(release)->load();
+    return rates;
+}
+
+//==============================================================================
+void VoiceEngine::handleMidiEvent(const juce::MidiMessage& message)
+{
+    const int midiChannel = message.getChannel();
+
+    if (message.isNoteOn())
+        noteOn(midiChannel, message.getNoteNumber());
+    else if (message.isNoteOff())
+        noteOff(midiChannel, message.getNoteNumber());
+    else if (message.isAllNotesOff() || message.isAllSoundOff())
+        releaseAllNotes(midiChannel);
+    else if (message.isSustainPedalOn() || message.isSustainPedalOff())
+        handleSustainPedal(midiChannel, message.isSustainPedalOn());
+    else if (message.isSostenutoPedalOn() || message.isSostenutoPedalOff())
+        handleSostenutoPedal(midiChannel, message.isSostenutoPedalOn());
+}
+
+void VoiceEngine::noteOn(int midiChannel, int midiNoteNumber)
+{
+    // a note still ringing, e.g. under the sustain pedal, is released first
+    for (int lane = 0; lane < numActive; ++lane)
+        if (note[lane] == midiNoteNumber && channel[lane] == midiChannel)
+            releaseLane(lane);
+
+    const int lane = allocateLane();
+
+    note[lane] = midiNoteNumber;
+    channel[lane] = midiChannel;
+    released[lane] = false;
+    keyDown[lane] = true;
+    sustainHeld[lane] = sustainPedalDown[midiChannel];
+    sostenutoHeld[lane] = false;
+    age[lane] = noteCounter++;
+    noiseState[lane] = (noteCounter * 2654435761u) | 1u;
+
+    // same tuning as SynthVoice::startNote
+    const int octave1 = (int)tree.getRawParameterValue("OSC_1_OCTAVE")->load();
+    const int octave2 = (int)tree.getRawParameterValue("OSC_2_OCTAVE")->load();
+    const int semitone1 = (int)tree.getRawParameterValue("OSC_1_SEMITONE")->load();
+    const int semitone2 = (int)tree.getRawParameterValue("OSC_2_SEMITONE")->load();
+    const float fineTune1 = tree.getRawParameterValue("OSC_1_FINE_TUNE")->load();
+    const float fineTune2 = tree.getRawParameterValue("OSC_2_FINE_TUNE")->load();
+
+    const double freq1 = 2 * std::pow(2.0, octave1 + fineTune1 / 1200) * juce::MidiMessage::getMidiNoteInHertz(midiNoteNumber + semitone1);
+    const double freq2 = 2 * std::pow(2.0, octave2 + fineTune2 / 1200) * juce::MidiMessage::getMidiNoteInHertz(midiNoteNumber + semitone2);
+
+    osc1.phase[lane] = 0.0f;
+    osc1.lastOutput[lane] = 0.0f;
+    osc1.increment[lane] = (float)(freq1 / sampleRate);
+    osc2.phase[lane] = 0.0f;
+    osc2.lastOutput[lane] = 0.0f;
+    osc2.increment[lane] = (float)(freq2 / sampleRate);
+
+    for (int i = 0; i < 5; ++i)
+    {
+        filter1.s[i][lane] = 0.0f;
+        filter2.s[i][lane] = 0.0f;
+    }
+
+    startEnvelope(ampEnvelope, params.amp, lane);
+    startEnvelope(filter1Envelope, params.filter1, lane);
+    startEnvelope(filter2Envelope, params.filter2, lane);
+}
+
+void VoiceEngine::noteOff(int midiChannel, int midiNoteNumber)
+{
+    for (int lane = 0; lane < numActive; ++lane)
+    {
+        if (note[lane] != midiNoteNumber || channel[lane] != midiChannel)
+            continue;
+
+        keyDown[lane] = false;
+        if (!sustainHeld[lane] && !sostenutoHeld[lane])
+            releaseLane(lane);
+    }
+}
+
+void VoiceEngine::releaseLane(int lane)
+{
+    if (released[lane])
+        return;
+
+    released[lane] = true;
+    releaseEnvelope(ampEnvelope, params.amp, lane);
+    releaseEnvelope(filter1Envelope, params.filter1, lane);
+    releaseEnvelope(filter2Envelope, params.filter2, lane);
+}
+
+/*
+ *  All notes off and all sound off let the channel's voices tail off and
+ *  lift every sustain pedal, as juce::Synthesiser::allNotesOff does
+ */
+void VoiceEngine::releaseAllNotes(int midiChannel)
+{
+    for (int lane = 0; lane < numActive; ++lane)
+        if (midiChannel <= 0 || channel[lane] == midiChannel)
+            releaseLane(lane);
+
+    std::memset(sustainPedalDown, 0, sizeof(sustainPedalDown));
+}
+
+void VoiceEngine::handleSustainPedal(int midiChannel, bool isDown)
+{
+    if (isDown)
+    {
+        sustainPedalDown[midiChannel] = true;
+
+        for (int lane = 0; lane < numActive; ++lane)
+            if (channel[lane] == midiChannel && keyDown[lane])
+                sustainHeld[lane] = true;
+    }
+    else
+    {
+        for (int lane = 0; lane < numActive; ++lane)
+        {
+            if (channel[lane] != midiChannel)
+                continue;
+
+            sustainHeld[lane] = false;
+            if (!keyDown[lane] && !sostenutoHeld[lane])
+                releaseLane(lane);
+        }
+
+        sustainPedalDown[midiChannel] = false;
+    }
+}
+
+/*
+ *  Same as juce::Synthesiser::handleSostenutoPedal, which holds every voice
+ *  of the channel and releases them all, held keys too, when it comes up
+ */
+void VoiceEngine::handleSostenutoPedal(int midiChannel, bool isDown)
+{
+    for (int lane = 0; lane < numActive; ++lane)
+    {
+        if (channel[lane] != midiChannel)
+            continue;
+
+        if (isDown)
+            sostenutoHeld[lane] = true;
+        else if (sostenutoHeld[lane])
+            releaseLane(lane);
+    }
+}
+
+/*
+ *  Puts the quietest held lanes into their release until no more than
+ *  polyphony are held, as SympleSynthesiser::releaseVoicesOverLimit does.
+ *  A lane still at the start of its attack hasn't been heard yet, so it is
+ *  only released when every held lane is new.
+ */
+void VoiceEngine::releaseLanesOverLimit()
+{
+    for (;;)
+    {
+        int numHeld = 0;
+        int quietest = -1;
+        int firstUnrendered = -1;
+
+        for (int lane = 0; lane < numActive; ++lane)
+        {
+            if (released[lane])
+                continue;
+
+            ++numHeld;
+            if (ampEnvelope.stage[lane] == ENV_ATTACK && ampEnvelope.level[lane] <= 0.0f)
+            {
+                if (firstUnrendered < 0)
+                    firstUnrendered = lane;
+            }
+            else if (quietest < 0 || ampEnvelope.level[lane] < ampEnvelope.level[quietest])
+            {
+                quietest = lane;
+            }
+        }
+
+        if (quietest < 0)
+            quietest = firstUnrendered;
+
+        if (numHeld <= polyphony || quietest < 0)
+            return;
+
+        releaseLane(quietest);
+    }
+}
+
+/*
+ *  Returns a free lane, stealing the quietest released voice
+ *  or else the oldest voice when the polyphony is used up
+ */
+int VoiceEngine::allocateLane()
+{
+    if (numActive < polyphony)
+        return numActive++;
+
+    int steal = -1;
+    for (int lane = 0; lane < numActive; ++lane)
+        if (released[lane] && (steal < 0 || ampEnvelope.level[lane] < ampEnvelope.level[steal]))
+            steal = lane;
+
+    if (steal < 0)
+    {
+        steal = 0;
+        for (int lane = 1; lane < numActive; ++lane)
+            if (age[lane] < age[steal])
+                steal = lane;
+    }
+
+    return steal;
+}
+
+/*
+ *  Frees a lane by moving the last active lane into it
+ */
+void VoiceEngine::freeLane(int lane)
+{
+    const int last = --numActive;
+
+    if (lane != last)
+        copyLane(last, lane);
+
+    ampEnvelope.stage[last] = ENV_IDLE;
+    ampEnvelope.level[last] = 0.0f;
+}
+
+void VoiceEngine::copyLane(int from, int to)
+{
+    note[to] = note[from];
+    channel[to] = channel[from];
+    released[to] = released[from];
+    keyDown[to] = keyDown[from];
+    sustainHeld[to] = sustainHeld[from];
+    sostenutoHeld[to] = sostenutoHeld[from];
+    age[to] = age[from];
+    noiseState[to] = noiseState[from];
+
+    for (auto* o : { &osc1, &osc2 })
+    {
+        o->phase[to] = o->phase[from];
+        o->increment[to] = o->increment[from];
+        o->lastOutput[to] = o->lastOutput[from];
+    }
+
+    for (auto* env : { &ampEnvelope, &filter1Envelope, &filter2Envelope })
+    {
+        env->level[to] = env->level[from];
+        env->releaseRate[to] = env->releaseRate[from];
+        env->stage[to] = env->stage[from];
+    }
+
+    for (auto* f : { &filter1, &filter2 })
+    {
+        for (int i = 0; i < 5; ++i)
+            f->s[i][to] = f->s[i][from];
+        f->a1[to] = f->a1[from];
+        f->b0[to] = f->b0[from];
+        f->b1[to] = f->b1[from];
+    }
+}
+
+/*
+ *  Frees voices whose amp envelope has finished or whose release
+ *  tail has dropped below the silence threshold
+ */
+void VoiceEngine::freeSilentVoices()
+{
+    const float gainSum = params.osc1Gain + params.osc2Gain + params.noise1Gain + params.noise2Gain;
+
+    for (int lane = numActive - 1; lane >= 0; --lane)
+    {
+        if (ampEnvelope.stage[lane] == ENV_IDLE
+            || (released[lane] && ampEnvelope.level[lane] * gainSum < silenceThreshold))
+            freeLane(lane);
+    }
+}
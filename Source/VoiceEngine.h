@@ -0,0 +1,168 @@
+/*
+  ==============================================================================
+
+    VoiceEngine.h
+    Created: 19 Oct 2026
+    Author:  woz
+    Notes: An alternative to juce::Synthesiser + SynthVoice that keeps the state
+           of every voice in structure-of-arrays form and renders the active
+           voices lane by lane, one stage at a time (oscillators, noise,
+           envelopes, filters). It uses the same parameters as SynthVoice but
+           updates filter cutoffs at control rate without per-sample smoothing.
+           The stage loops are LaneKernels, picked for the cpu in prepare.
+
+           Note, pedal and all notes off messages follow the juce::Synthesiser
+           rules, so MIDI plays the same on either path: a held sustain pedal
+           keeps released keys sounding, sostenuto holds the voices that were
+           playing when it went down, and a repeated note releases the voice
+           still ringing on that note first.
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "Osc.h"
+#include "Filter.h"
+#include "LaneKernels.h"
+
+class VoiceEngine
+{
+public:
+    static constexpr int maxVoices = 256;
+    static constexpr int laneBlockSize = LaneKernels::numLanes;   // voices processed together by each stage
+    static constexpr int subBlockSize = 32;    // samples per stage pass, also the control rate
+
+    explicit VoiceEngine(juce::AudioProcessorValueTreeState&);
+
+    /* sets the sample rate, picks the lane kernels and clears all voices */
+    void prepare(const juce::dsp::ProcessSpec& spec);
+
+    /* Caps the instruction set used from the next prepare, to compare variants */
+    void setMaximumSimdLevel(SimdLevel level) { maximumSimdLevel = level; }
+    SimdLevel getSimdLevel() const { return kernels->level; }
+
+    /* limits the number of voices that can play at once. When it goes down,
+       the quietest held voices over it are released at the next render */
+    void setPolyphony(int numVoices);
+    int getPolyphony() const { return polyphony; }
+
+    /* Sets the level (in dB) below which a released voice is freed */
+    void setSilenceThreshold(float decibels);
+
+    /* renders the voices into outputBuffer, handling the note messages in midi */
+    void renderNextBlock(juce::AudioBuffer<float>& outputBuffer, const juce::MidiBuffer& midi,
+                         const juce::dsp::AudioBlock<float>& lfoBuffer, int startSample, int numSamples);
+
+    void allNotesOff();
+    int getNumActiveVoices() const { return numActive; }
+
+private:
+    enum EnvelopeStage { ENV_IDLE, ENV_ATTACK, ENV_DECAY, ENV_SUSTAIN, ENV_RELEASE };
+
+    /* linear ADSR lanes that follow the juce::ADSR rules */
+    struct EnvelopeLanes
+    {
+        alignas(32) float level[maxVoices];
+        alignas(32) float releaseRate[maxVoices];
+        int stage[maxVoices];
+    };
+
+    /* rates shared by every lane of an envelope, taken from the parameters */
+    struct EnvelopeRates
+    {
+        float attack, decay, sustain, release;
+    };
+
+    struct OscillatorLanes
+    {
+        alignas(32) float phase[maxVoices];     // 0 to 1
+        alignas(32) float increment[maxVoices];
+        alignas(32) float lastOutput[maxVoices]; // triangle leaky integrator
+    };
+
+    struct FilterLanes
+    {
+        alignas(32) float s[5][maxVoices];
+        alignas(32) float a1[maxVoices];
+        alignas(32) float b0[maxVoices];
+        alignas(32) float b1[maxVoices];
+    };
+
+    /* output mix of the ladder stages for a filter mode, as Filter::setMode builds it */
+    struct FilterMix
+    {
+        std::array<float, 5> a;
+        float comp;
+    };
+
+    /* parameter values read once per block */
+    struct BlockParameters
+    {
+        OscillatorMode osc1Mode, osc2Mode;
+        float osc1Gain, osc2Gain, noise1Gain, noise2Gain;
+        float cutoff1, cutoff2, resonance1, resonance2, amount1, amount2, lfoAmount;
+        FilterMix mix1, mix2;
+        EnvelopeRates amp, filter1, filter2;
+    };
+
+    juce::AudioProcessorValueTreeState& tree;
+    double sampleRate = 44100.0;
+    float cutoffFreqScaler = 0.0f;
+    float drive, drive2, driveGain, driveGain2;
+    int polyphony = 64;
+    int numActive = 0;
+    uint32_t noteCounter = 0;
+    float silenceThreshold = juce::Decibels::decibelsToGain(-100.0f);
+    BlockParameters params;
+    SimdLevel maximumSimdLevel = SimdLevel::AVX512;
+    const LaneKernels::Table* kernels;
+
+    // lane state, the first numActive lanes are the playing voices
+    int note[maxVoices];
+    int channel[maxVoices];
+    bool released[maxVoices];
+    bool keyDown[maxVoices];
+    bool sustainHeld[maxVoices];    // released keys keep sounding while these are set
+    bool sostenutoHeld[maxVoices];
+    bool sustainPedalDown[17];      // per midi channel, 1 to 16
+    uint32_t age[maxVoices];
+    uint32_t noiseState[maxVoices];
+    OscillatorLanes osc1, osc2;
+    EnvelopeLanes ampEnvelope, filter1Envelope, filter2Envelope;
+    FilterLanes filter1, filter2;
+
+    // scratch for one lane block, laid out [sample][lane]
+    alignas(32) float path1[subBlockSize][laneBlockSize];
+    alignas(32) float path2[subBlockSize][laneBlockSize];
+    alignas(32) float envelope[subBlockSize][laneBlockSize];
+
+    void readParameters();
+    EnvelopeRates readEnvelopeRates(const char* attack, const char* decay, const char* sustain, const char* release) const;
+    static FilterMix filterMix(FilterMode mode);
+
+    void handleMidiEvent(const juce::MidiMessage&);
+    void noteOn(int midiChannel, int midiNoteNumber);
+    void startEnvelope(EnvelopeLanes&, const EnvelopeRates&, int lane);
+    void releaseEnvelope(EnvelopeLanes&, const EnvelopeRates&, int lane);
+    void noteOff(int midiChannel, int midiNoteNumber);
+    void releaseLane(int lane);
+    void releaseAllNotes(int midiChannel);
+    void handleSustainPedal(int midiChannel, bool isDown);
+    void handleSostenutoPedal(int midiChannel, bool isDown);
+    void releaseLanesOverLimit();
+    int allocateLane();
+    void freeLane(int lane);
+    void copyLane(int from, int to);
+
+    void renderRange(juce::AudioBuffer<float>& outputBuffer, const juce::dsp::AudioBlock<float>& lfoBuffer, int startSample, int numSamples);
+    void renderSubBlock(float* output, const juce::dsp::AudioBlock<float>& lfoBuffer, int lfoSample, int numSamples);
+    void updateFilterCoefficients(FilterLanes&, const EnvelopeLanes&, float cutoff, float amount, float lfoValue, int first);
+    void renderEnvelopeLanes(EnvelopeLanes&, const EnvelopeRates&, int first, int numSamples, float (*out)[laneBlockSize]);
+    void advanceEnvelopeLanes(EnvelopeLanes&, const EnvelopeRates&, int first, int numSamples);
+    void renderFilterLanes(FilterLanes&, const FilterMix& mix, float resonance, int first, int numSamples, float (*io)[laneBlockSize]);
+    void renderOscillatorLanes(OscillatorMode, OscillatorLanes&, int first, int numSamples, float gain, float (*out)[laneBlockSize]);
+    void freeSilentVoices();
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (VoiceEngine)
+};
@@ -0,0 +1,71 @@
+/*
+  ==============================================================================
+
+    VoiceKernel.cpp
+    Created: 19 Oct 2026
+    Author:  woz
+
+  ==============================================================================
+*/
+
+#include "VoiceKernel.h"
+
+namespace
+{
+    constexpr int numOscillatorModes = 4; // sine, saw, square, triangle
+    constexpr int numFilterModes = 6;
+
+    template <OscillatorMode OscMode, bool WithNoise, FilterMode FiltMode, bool Smoothing>
+    void renderFusedPath(FusedVoicePath& path, const float* envelope, juce::dsp::AudioBlock<float>& output, int numSamples)
+    {
+        auto& filter = path.filter;
+        auto* out = output.getChannelPointer(0);
+        auto k = filter.getFrozenCoefficients();
+
+        for (int sample = 0; sample < numSamples; ++sample)
+        {
+            // same rounding as Oscillator::generate adding into a float buffer
+            float x = (float)((float)path.osc.nextSample<OscMode>() * path.oscGain);
+
+            if (WithNoise)
+                x += (float)((float)path.noise.nextSample<OSCILLATOR_MODE_NOISE>() * path.noiseGain);
+
+            if (Smoothing)
+                k = filter.getNextCoefficients();
+
+            out[sample] = filter.processFirstChannelSample<FiltMode>(x * envelope[sample], k);
+        }
+
+        // every channel carries the same mono voice
+        for (size_t channel = 1; channel < output.getNumChannels(); ++channel)
+            juce::FloatVectorOperations::copy(output.getChannelPointer(channel), out, numSamples);
+
+        filter.mirrorFirstChannelState();
+    }
+
+    // table index: ((oscMode * 2 + withNoise) * numFilterModes + filterMode) * 2 + smoothing
+    template <size_t Index>
+    constexpr FusedVoiceKernel kernelForIndex()
+    {
+        return &renderFusedPath<static_cast<OscillatorMode>(Index / (2 * numFilterModes * 2)),
+                                ((Index / (numFilterModes * 2)) % 2) == 1,
+                                static_cast<FilterMode>((Index / 2) % numFilterModes),
+                                (Index % 2) == 1>;
+    }
+
+    template <size_t... Indices>
+    constexpr std::array<FusedVoiceKernel, sizeof...(Indices)> makeKernelTable(std::index_sequence<Indices...>)
+    {
+        return {{ kernelForIndex<Indices>()... }};
+    }
+
+    constexpr auto kernelTable = makeKernelTable(std::make_index_sequence<numOscillatorModes * 2 * numFilterModes * 2>());
+}
+
+FusedVoiceKernel getFusedVoiceKernel(OscillatorMode oscMode, bool withNoise, FilterMode filterMode, bool smoothing)
+{
+    jassert((int)oscMode >= 0 && (int)oscMode < numOscillatorModes);
+
+    const auto index = ((((size_t)oscMode * 2 + (withNoise ? 1 : 0)) * numFilterModes + (size_t)filterMode) * 2) + (smoothing ? 1 : 0);
+    return kernelTable[index];
+}
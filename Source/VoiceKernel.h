@@ -0,0 +1,34 @@
+/*
+  ==============================================================================
+
+    VoiceKernel.h
+    Created: 19 Oct 2026
+    Author:  woz
+    Notes: Fused oscillator -> envelope -> filter kernels for SynthVoice.
+           One kernel is compiled for every combination of oscillator mode,
+           noise on/off, filter mode and filter smoothing, so each sample is
+           generated, enveloped and filtered in registers and stored once.
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "Osc.h"
+#include "Filter.h"
+
+/* One signal path of a voice: an oscillator plus noise feeding a filter */
+struct FusedVoicePath
+{
+    Oscillator& osc;
+    Oscillator& noise;
+    Filter<float>& filter;
+    double oscGain;     // linear gain
+    double noiseGain;   // linear gain
+};
+
+/* Renders numSamples of a path into output, which is overwritten */
+using FusedVoiceKernel = void (*)(FusedVoicePath&, const float* envelope, juce::dsp::AudioBlock<float>& output, int numSamples);
+
+/* Returns the kernel compiled for the given oscillator, noise and filter state */
+FusedVoiceKernel getFusedVoiceKernel(OscillatorMode oscMode, bool withNoise, FilterMode filterMode, bool smoothing);
@@ -0,0 +1,119 @@
+/*
+  ==============================================================================
+
+    VoiceRenderPool.cpp
+    Created: 19 Oct 2026
+    Author:  woz
+
+  ==============================================================================
+*/
+
+#include "VoiceRenderPool.h"
+
+class VoiceRenderPool::Worker : public juce::Thread
+{
+public:
+    Worker(VoiceRenderPool& p, int numChannels, int maxBlockSize)
+        : juce::Thread("SympleSynth voice renderer"), pool(p), buffer(numChannels, maxBlockSize),
+          // read before the thread starts, a block handed out before run()
+          // gets going must still look new to it
+          seen(p.generation.load(std::memory_order_acquire))
+    {
+    }
+
+    ~Worker() override
+    {
+        signalThreadShouldExit();
+        notify();
+        stopThread(2000);
+    }
+
+    void run() override
+    {
+        while (!threadShouldExit())
+        {
+            const auto current = pool.generation.load(std::memory_order_acquire);
+
+            if (current == seen)
+            {
+                // sleeps until render() hands out a block or the pool stops
+                wait(-1);
+                continue;
+            }
+
+            seen = current;
+
+            buffer.clear(pool.job.startSample, pool.job.numSamples);
+            pool.renderShare(buffer);
+            pool.numBusyWorkers.fetch_sub(1, std::memory_order_acq_rel);
+        }
+    }
+
+    juce::AudioBuffer<float>& getBuffer() { return buffer; }
+
+private:
+    VoiceRenderPool& pool;
+    juce::AudioBuffer<float> buffer;
+    juce::uint32 seen;
+};
+
+VoiceRenderPool::~VoiceRenderPool()
+{
+    release();
+}
+
+void VoiceRenderPool::prepare(int numWorkers, int numChannels, int maxBlockSize)
+{
+    release();
+
+    for (int i = 0; i < numWorkers; ++i)
+        workers.add(new Worker(*this, numChannels, maxBlockSize))->startThread();
+}
+
+void VoiceRenderPool::release()
+{
+    for (auto* worker : workers)
+    {
+        worker->signalThreadShouldExit();
+        worker->notify();
+    }
+
+    workers.clear();
+}
+
+void VoiceRenderPool::render(const juce::OwnedArray<juce::SynthesiserVoice>& voices, juce::AudioBuffer<float>& output,
+                             int startSample, int numSamples)
+{
+    job = { &voices, startSample, numSamples };
+    nextVoice.store(0, std::memory_order_relaxed);
+    numBusyWorkers.store(workers.size(), std::memory_order_relaxed);
+    generation.fetch_add(1, std::memory_order_acq_rel);
+
+    for (auto* worker : workers)
+        worker->notify();
+
+    renderShare(output);
+
+    while (numBusyWorkers.load(std::memory_order_acquire) > 0)
+        juce::Thread::yield();
+
+    for (auto* worker : workers)
+        for (int channel = 0; channel < output.getNumChannels(); ++channel)
+            output.addFrom(channel, startSample, worker->getBuffer(), channel, startSample, numSamples);
+}
+
+/*
+ *  Takes voices until there are none left, each voice is rendered by
+ *  exactly one thread. Which thread gets which voice changes from block to
+ *  block, so the sum can differ from a serial render in the last bits.
+ */
+void VoiceRenderPool::renderShare(juce::AudioBuffer<float>& buffer)
+{
+    const auto& voices = *job.voices;
+
+    for (int index = nextVoice.fetch_add(1, std::memory_order_relaxed); index < voices.size();
+         index = nextVoice.fetch_add(1, std::memory_order_relaxed))
+    {
+        voices.getUnchecked(index)->renderNextBlock(buffer, job.startSample, job.numSamples);
+    }
+}
@@ -0,0 +1,63 @@
+/*
+  ==============================================================================
+
+    VoiceRenderPool.h
+    Created: 19 Oct 2026
+    Author:  woz
+    Notes: Renders the voices of a juce::Synthesiser on several threads, for
+           non-realtime renders where there is no deadline to protect and
+           every core may as well be busy.
+
+           The calling thread hands out voices through an atomic counter and
+           renders its share straight into the output, the workers render
+           theirs into their own buffers which are added in afterwards. No
+           allocation in render(): idle workers sleep on their thread's event
+           until render() wakes them, and the caller spins until they are
+           done. Waking a worker takes the event's lock for a moment, which
+           the worker only holds while going to sleep.
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+class VoiceRenderPool
+{
+public:
+    VoiceRenderPool() = default;
+    ~VoiceRenderPool();
+
+    /* Starts the worker threads and sizes their buffers. Not realtime safe */
+    void prepare(int numWorkers, int numChannels, int maxBlockSize);
+
+    /* Stops the worker threads */
+    void release();
+
+    int getNumWorkers() const { return workers.size(); }
+
+    /* Renders every voice into output, which they add to, like
+       juce::Synthesiser::renderVoices does */
+    void render(const juce::OwnedArray<juce::SynthesiserVoice>& voices, juce::AudioBuffer<float>& output,
+                int startSample, int numSamples);
+
+private:
+    class Worker;
+
+    struct Job
+    {
+        const juce::OwnedArray<juce::SynthesiserVoice>* voices = nullptr;
+        int startSample = 0;
+        int numSamples = 0;
+    };
+
+    juce::OwnedArray<Worker> workers;
+    Job job;
+    std::atomic<juce::uint32> generation { 0 };  // bumped for every block
+    std::atomic<int> nextVoice { 0 };
+    std::atomic<int> numBusyWorkers { 0 };
+
+    void renderShare(juce::AudioBuffer<float>& buffer);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (VoiceRenderPool)
+};
@@ -0,0 +1,570 @@
+/*
+  ==============================================================================
+
+    Benchmarks.cpp
+    Created: 19 Oct 2026
+    Author:  woz
+
+  ==============================================================================
+*/
+
+#include "Benchmarks.h"
+#include <iostream>
+#include "../../SympleRender/Source/OfflineRenderer.h"
+#include "../../../Source/PluginState.h"
+
+#if JUCE_LINUX
+ #include <linux/perf_event.h>
+ #include <sys/ioctl.h>
+ #include <sys/syscall.h>
+ #include <unistd.h>
+#endif
+
+namespace
+{
+    constexpr double microRate = 48000.0;
+    constexpr int microBlockSize = 512;
+
+    const char* getOscillatorName(int mode)
+    {
+        const char* names[] = { "sine", "saw", "square", "triangle", "noise" };
+        return names[mode];
+    }
+
+    const char* getFilterName(int mode)
+    {
+        const char* names[] = { "LPF12", "HPF12", "BPF12", "LPF24", "HPF24", "BPF24" };
+        return names[mode];
+    }
+
+    /* Sixteen lanes of VoiceEngine state, each voice a fifth above the last */
+    struct LaneState
+    {
+        float phase[LaneKernels::numLanes], increment[LaneKernels::numLanes], lastOutput[LaneKernels::numLanes];
+        uint32_t noise[LaneKernels::numLanes];
+        float s[5][LaneKernels::numLanes], a1[LaneKernels::numLanes], b0[LaneKernels::numLanes], b1[LaneKernels::numLanes];
+        float path[VoiceEngine::subBlockSize][LaneKernels::numLanes];
+
+        LaneState()
+        {
+            std::memset(this, 0, sizeof(*this));
+
+            for (int lane = 0; lane < LaneKernels::numLanes; ++lane)
+            {
+                increment[lane] = (float)(110.0 * std::pow(1.5, lane % 6) / microRate);
+                noise[lane] = (uint32_t)(lane + 1) * 2654435761u;
+                a1[lane] = std::exp(-2.0f * juce::MathConstants<float>::pi * 2000.0f / (float)microRate);
+                b0[lane] = (1.0f - a1[lane]) * 0.76923076923f;
+                b1[lane] = (1.0f - a1[lane]) * 0.23076923076f;
+            }
+        }
+
+        LaneKernels::FilterArgs getFilterArgs()
+        {
+            LaneKernels::FilterArgs args { { s[0], s[1], s[2], s[3], s[4] }, a1, b0, b1,
+                                           { 0.0f, 0.0f, 0.0f, 0.0f, 1.2f }, 0.5f, 0.55f, 1.2f, 0.8f, 1.0f, 1.0f };
+            return args;
+        }
+    };
+
+    /* Note on events for a chord spread over the keyboard. Stepping by fifths
+       through eight octaves gives a different note for up to 96 voices, so
+       every voice is a note of its own rather than a retrigger */
+    juce::MidiMessageSequence makeChord(int numNotes)
+    {
+        constexpr int lowestNote = 24;
+        constexpr int numKeys = 96;
+        jassert(numNotes <= numKeys);
+
+        juce::MidiMessageSequence sequence;
+        for (int i = 0; i < juce::jmin(numNotes, numKeys); ++i)
+            sequence.addEvent(juce::MidiMessage::noteOn(1, lowestNote + (i * 7) % numKeys, 0.8f), 0.0);
+        return sequence;
+    }
+
+    /* Instructions retired and last level cache misses on the calling thread,
+       from perf_event_open. Not available on other platforms */
+    class HardwareCounters
+    {
+    public:
+        HardwareCounters()
+        {
+           #if JUCE_LINUX
+            instructions = open(PERF_COUNT_HW_INSTRUCTIONS);
+            cacheMisses = open(PERF_COUNT_HW_CACHE_MISSES);
+           #endif
+        }
+
+        ~HardwareCounters()
+        {
+           #if JUCE_LINUX
+            for (auto fd : { instructions, cacheMisses })
+                if (fd >= 0)
+                    close(fd);
+           #endif
+        }
+
+        bool isAvailable() const { return instructions >= 0 && cacheMisses >= 0; }
+
+        void start()
+        {
+           #if JUCE_LINUX
+            for (auto fd : { instructions, cacheMisses })
+            {
+                ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+           #endif
+        }
+
+        void stop()
+        {
+           #if JUCE_LINUX
+            for (auto fd : { instructions, cacheMisses })
+                ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+           #endif
+        }
+
+        juce::int64 getInstructions() const { return readCount(instructions); }
+        juce::int64 getCacheMisses() const  { return readCount(cacheMisses); }
+
+    private:
+        int instructions = -1;
+        int cacheMisses = -1;
+
+       #if JUCE_LINUX
+        static int open(juce::uint64 event)
+        {
+            perf_event_attr attributes {};
+            attributes.type = PERF_TYPE_HARDWARE;
+            attributes.size = sizeof(attributes);
+            attributes.config = event;
+            attributes.disabled = 1;
+            attributes.exclude_kernel = 1;
+            attributes.exclude_hv = 1;
+            return (int)syscall(__NR_perf_event_open, &attributes, 0, -1, -1, 0);
+        }
+       #endif
+
+        static juce::int64 readCount(int fd)
+        {
+            long long count = 0;
+           #if JUCE_LINUX
+            if (fd < 0 || read(fd, &count, sizeof(count)) != (ssize_t)sizeof(count))
+                return 0;
+           #else
+            juce::ignoreUnused(fd);
+           #endif
+            return (juce::int64)count;
+        }
+    };
+}
+
+Benchmarks::Benchmarks(const BenchmarkSettings& s)
+    : settings(s)
+{
+}
+
+/*
+ *  Runs the function a few times and keeps the fastest run, which is the one
+ *  least disturbed by the rest of the system. The hardware counts kept are
+ *  from that same run.
+ */
+template <typename Function>
+double Benchmarks::measure(Function&& function)
+{
+    double best = std::numeric_limits<double>::max();
+    HardwareCounters counters;
+    lastCounters = {};
+
+    for (int repeat = 0; repeat < juce::jmax(1, settings.repeats); ++repeat)
+    {
+        counters.start();
+        const auto start = juce::Time::getHighResolutionTicks();
+        function();
+        const auto end = juce::Time::getHighResolutionTicks();
+        counters.stop();
+
+        const double seconds = juce::Time::highResolutionTicksToSeconds(end - start);
+        if (seconds < best)
+        {
+            best = seconds;
+            if (counters.isAvailable())
+                lastCounters = { true, counters.getInstructions(), counters.getCacheMisses() };
+        }
+    }
+
+    return best;
+}
+
+/* Call straight after the measure() the seconds came from */
+juce::var Benchmarks::makeResult(const juce::String& name, double seconds, juce::int64 numSamples) const
+{
+    auto* result = new juce::DynamicObject();
+    result->setProperty("name", name);
+    result->setProperty("seconds", seconds);
+    result->setProperty("samples", numSamples);
+    result->setProperty("nsPerSample", seconds * 1.0e9 / (double)numSamples);
+
+    if (lastCounters.valid)
+    {
+        // every last level miss reads a 64 byte line, a floor on the memory traffic
+        result->setProperty("instructionsPerSample", lastCounters.instructions / (double)numSamples);
+        result->setProperty("memoryBytesPerSample", lastCounters.cacheMisses * 64.0 / (double)numSamples);
+    }
+
+    return juce::var(result);
+}
+
+juce::var Benchmarks::runOscillators()
+{
+    juce::Array<juce::var> results;
+    juce::HeapBlock<float> memory(microBlockSize, true);
+    float* channels[] = { memory.get() };
+    juce::dsp::AudioBlock<float> block(channels, 1, microBlockSize);
+    const int numBlocks = (int)(settings.secondsPerRun * microRate) / microBlockSize;
+
+    for (int mode = OSCILLATOR_MODE_SINE; mode <= OSCILLATOR_MODE_NOISE; ++mode)
+    {
+        Oscillator oscillator;
+        oscillator.setSampleRate(microRate);
+        oscillator.setMode(static_cast<OscillatorMode>(mode));
+        oscillator.setFrequency(440.0);
+        oscillator.startNote();
+
+        const double seconds = measure([&]
+        {
+            for (int i = 0; i < numBlocks; ++i)
+                oscillator.generate(block, microBlockSize, -6.0);
+        });
+
+        results.add(makeResult(juce::String("oscillator/") + getOscillatorName(mode), seconds,
+                               (juce::int64)numBlocks * microBlockSize));
+    }
+
+    return results;
+}
+
+juce::var Benchmarks::runFilters()
+{
+    juce::Array<juce::var> results;
+    juce::AudioBuffer<float> buffer(2, microBlockSize);
+    juce::Random random(1);
+    const int numBlocks = (int)(settings.secondsPerRun * microRate) / microBlockSize;
+
+    for (int mode = 0; mode <= (int)FilterMode::BPF24; ++mode)
+    {
+        for (const bool modulated : { false, true })
+        {
+            Filter<float> filter;
+            filter.prepare({ microRate, (juce::uint32)microBlockSize, 2 });
+            filter.setMode(static_cast<FilterMode>(mode));
+            filter.setCutoffFrequencyHz(1000.0f);
+            filter.setResonance(0.5f);
+
+            const double seconds = measure([&]
+            {
+                for (int i = 0; i < numBlocks; ++i)
+                {
+                    // noise keeps the filter away from denormals
+                    for (int channel = 0; channel < 2; ++channel)
+                        for (int sample = 0; sample < microBlockSize; ++sample)
+                            buffer.setSample(channel, sample, random.nextFloat() * 2.0f - 1.0f);
+
+                    if (modulated)
+                        filter.setCutoffFrequencyHz(500.0f + 1000.0f * (float)(i & 7));
+
+                    juce::dsp::AudioBlock<float> block(buffer);
+                    filter.process(juce::dsp::ProcessContextReplacing<float>(block));
+                }
+            });
+
+            results.add(makeResult(juce::String("filter/") + getFilterName(mode) + (modulated ? "/modulated" : "/fixed"),
+                                   seconds, (juce::int64)numBlocks * microBlockSize));
+        }
+    }
+
+    // the noise fill is part of every filter run, report it so it can be subtracted
+    const double fillSeconds = measure([&]
+    {
+        for (int i = 0; i < numBlocks; ++i)
+            for (int channel = 0; channel < 2; ++channel)
+                for (int sample = 0; sample < microBlockSize; ++sample)
+                    buffer.setSample(channel, sample, random.nextFloat() * 2.0f - 1.0f);
+    });
+    results.add(makeResult("filter/noiseFill", fillSeconds, (juce::int64)numBlocks * microBlockSize));
+
+    return results;
+}
+
+/*
+ *  Runs each kernel over sub blocks of sixteen lanes, so nsPerSample is the
+ *  cost of one sample of sixteen voices. Every level also renders the same
+ *  second of saw through the filter as the scalar kernels, and reports the
+ *  largest difference between them, failing over LaneKernels::maxDifferenceFromScalar.
+ */
+juce::var Benchmarks::runLaneKernels()
+{
+    juce::Array<juce::var> results;
+    const int numSubBlocks = (int)(settings.secondsPerRun * microRate) / VoiceEngine::subBlockSize;
+    const auto numSamples = (juce::int64)numSubBlocks * VoiceEngine::subBlockSize;
+    const int referenceSubBlocks = (int)microRate / VoiceEngine::subBlockSize;
+
+    auto renderReference = [referenceSubBlocks] (const LaneKernels::Table& kernels)
+    {
+        LaneState state;
+        std::vector<float> output;
+        const auto args = state.getFilterArgs();
+
+        for (int i = 0; i < referenceSubBlocks; ++i)
+        {
+            kernels.oscillator[OSCILLATOR_MODE_SAW](state.phase, state.increment, state.lastOutput, VoiceEngine::subBlockSize, 0.5f, state.path);
+            kernels.filter(args, VoiceEngine::subBlockSize, state.path);
+            output.insert(output.end(), &state.path[0][0], &state.path[0][0] + VoiceEngine::subBlockSize * LaneKernels::numLanes);
+        }
+
+        return output;
+    };
+
+    const auto scalarOutput = renderReference(LaneKernels::getTable(SimdLevel::Scalar));
+
+    for (auto level : { SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::AVX512 })
+    {
+        if (level > LaneKernels::getCpuLevel())
+            break;
+
+        const auto& kernels = LaneKernels::getTable(level);
+        const juce::String prefix = juce::String("lanes/") + LaneKernels::getLevelName(level) + "/";
+        LaneState state;
+
+        for (int mode = OSCILLATOR_MODE_SINE; mode <= OSCILLATOR_MODE_TRIANGLE; ++mode)
+        {
+            const double seconds = measure([&]
+            {
+                for (int i = 0; i < numSubBlocks; ++i)
+                    kernels.oscillator[mode](state.phase, state.increment, state.lastOutput, VoiceEngine::subBlockSize, 0.5f, state.path);
+            });
+            results.add(makeResult(prefix + "oscillator/" + getOscillatorName(mode), seconds, numSamples));
+        }
+
+        const double noiseSeconds = measure([&]
+        {
+            for (int i = 0; i < numSubBlocks; ++i)
+                kernels.noise(state.noise, VoiceEngine::subBlockSize, 0.5f, state.path);
+        });
+        results.add(makeResult(prefix + "noise", noiseSeconds, numSamples));
+
+        const auto args = state.getFilterArgs();
+        const double filterSeconds = measure([&]
+        {
+            for (int i = 0; i < numSubBlocks; ++i)
+                kernels.filter(args, VoiceEngine::subBlockSize, state.path);
+        });
+        results.add(makeResult(prefix + "filter", filterSeconds, numSamples));
+
+        const auto output = renderReference(kernels);
+        float maxDifference = 0.0f;
+        for (size_t i = 0; i < output.size(); ++i)
+            maxDifference = juce::jmax(maxDifference, std::abs(output[i] - scalarOutput[i]));
+
+        auto* difference = new juce::DynamicObject();
+        difference->setProperty("name", prefix + "maxDifferenceFromScalar");
+        difference->setProperty("value", maxDifference);
+        difference->setProperty("limit", LaneKernels::maxDifferenceFromScalar);
+        difference->setProperty("passed", maxDifference <= LaneKernels::maxDifferenceFromScalar);
+        results.add(juce::var(difference));
+
+        if (maxDifference > LaneKernels::maxDifferenceFromScalar)
+        {
+            std::cerr << prefix << " differs from the scalar kernels by " << maxDifference << std::endl;
+            ++failures;
+        }
+    }
+
+    return results;
+}
+
+/*
+ *  Times one voice on its own. The processor only supplies the parameter tree,
+ *  its synth is never run.
+ */
+juce::var Benchmarks::runVoices()
+{
+    juce::Array<juce::var> results;
+    SympleSynthAudioProcessor processor;
+    SynthSound sound;
+    const int eventSample = -1;
+
+    juce::HeapBlock<float> lfoMemory(microBlockSize, true);
+    float* lfoChannels[] = { lfoMemory.get() };
+    juce::dsp::AudioBlock<float> lfoBuffer(lfoChannels, 1, microBlockSize);
+
+    juce::AudioBuffer<float> output(2, microBlockSize);
+    const juce::dsp::ProcessSpec spec { microRate, (juce::uint32)microBlockSize, 2 };
+    const int sustainBlocks = (int)(settings.secondsPerRun * microRate) / microBlockSize;
+    const int attackBlocks = juce::jmax(1, (int)(0.05 * microRate) / microBlockSize);
+    const int releaseBlocks = juce::jmax(1, (int)(0.5 * microRate) / microBlockSize);
+
+    for (const bool fused : { true, false })
+    {
+        SynthVoice voice(processor.getTree(), lfoBuffer, eventSample);
+        voice.setCurrentPlaybackSampleRate(microRate);
+        voice.prepare(spec);
+        voice.setFusedRendering(fused);
+        const juce::String prefix = juce::String("voice/") + (fused ? "fused/" : "unfused/");
+
+        auto renderBlocks = [&] (int numBlocks)
+        {
+            for (int i = 0; i < numBlocks; ++i)
+            {
+                output.clear();
+                voice.renderNextBlock(output, 0, microBlockSize);
+            }
+        };
+
+        // the first blocks of a note, including the note on itself
+        const double attack = measure([&]
+        {
+            for (int note = 0; note < 16; ++note)
+            {
+                voice.startNote(48 + note, 0.8f, &sound, 8192);
+                renderBlocks(attackBlocks);
+                voice.stopNote(0.0f, false);
+                renderBlocks(1);
+            }
+        });
+        results.add(makeResult(prefix + "noteOn", attack, (juce::int64)16 * (attackBlocks + 1) * microBlockSize));
+
+        // a held note
+        voice.startNote(60, 0.8f, &sound, 8192);
+        renderBlocks(attackBlocks);
+        const double sustain = measure([&] { renderBlocks(sustainBlocks); });
+        results.add(makeResult(prefix + "sustain", sustain, (juce::int64)sustainBlocks * microBlockSize));
+
+        // release tails, which end early once they fall below the silence threshold
+        const double release = measure([&]
+        {
+            voice.stopNote(0.0f, true);
+            renderBlocks(releaseBlocks);
+            voice.startNote(60, 0.8f, &sound, 8192);
+            renderBlocks(attackBlocks);
+        });
+        results.add(makeResult(prefix + "release", release, (juce::int64)(releaseBlocks + attackBlocks) * microBlockSize));
+
+        voice.stopNote(0.0f, false);
+        renderBlocks(1);
+    }
+
+    return results;
+}
+
+/*
+ *  Holds a chord and times processBlock once the attacks are over. The cost of
+ *  the same processor with no notes is taken off to get the cost per voice,
+ *  which gives how many voices fit in the deadline on one core.
+ */
+juce::var Benchmarks::runProcessBlock()
+{
+    juce::Array<juce::var> results;
+
+    for (auto sampleRate : settings.sampleRates)
+    {
+        for (auto blockSize : settings.blockSizes)
+        {
+            RenderSettings renderSettings;
+            renderSettings.sampleRate = sampleRate;
+            renderSettings.blockSize = blockSize;
+            renderSettings.tailSeconds = 0.5;
+            renderSettings.nonRealtime = false;
+            renderSettings.useVoiceEngine = settings.useVoiceEngine;
+
+            OfflineRenderer renderer(renderSettings);
+            juce::AudioBuffer<float> scratch;
+            const int numSamples = (int)(settings.secondsPerRun * sampleRate);
+            const double blockPeriod = blockSize / sampleRate;
+
+            renderer.getProcessor().setNumVoices(0);
+            renderer.render({}, scratch);
+            const double idleSeconds = measure([&] { renderer.renderSilence(numSamples); });
+            const double idlePerBlock = idleSeconds * blockSize / numSamples;
+
+            for (auto numVoices : settings.voiceCounts)
+            {
+                renderer.getProcessor().setNumVoices(numVoices);
+                renderer.getProcessor().setVoiceEnginePolyphony(numVoices);
+                renderer.render(makeChord(numVoices), scratch);
+
+                const double seconds = measure([&] { renderer.renderSilence(numSamples); });
+                const double perBlock = seconds * blockSize / numSamples;
+                const double perVoice = juce::jmax(1.0e-12, (perBlock - idlePerBlock) / numVoices);
+
+                auto result = makeResult("processBlock", seconds, numSamples);
+                auto* object = result.getDynamicObject();
+                object->setProperty("engine", settings.useVoiceEngine ? "voiceEngine" : "synthesiser");
+                object->setProperty("sampleRate", sampleRate);
+                object->setProperty("blockSize", blockSize);
+                object->setProperty("voices", numVoices);
+                object->setProperty("blockLoad", perBlock / blockPeriod);
+                object->setProperty("voicesPerCore", juce::jmax(0.0, (settings.deadline * blockPeriod - idlePerBlock) / perVoice));
+                results.add(result);
+            }
+        }
+    }
+
+    return results;
+}
+
+juce::var Benchmarks::runStateLoading()
+{
+    juce::Array<juce::var> results;
+    SympleSynthAudioProcessor processor;
+    const int numLoads = 1000;
+
+    juce::MemoryBlock binaryState, xmlState;
+    processor.getStateInformation(binaryState);
+    PluginState::writeXml(processor.getTree(), xmlState);
+
+    for (auto* state : { &binaryState, &xmlState })
+    {
+        const double seconds = measure([&]
+        {
+            for (int i = 0; i < numLoads; ++i)
+                processor.setStateInformation(state->getData(), (int)state->getSize());
+        });
+
+        auto* result = new juce::DynamicObject();
+        result->setProperty("name", state == &binaryState ? "state/binary" : "state/xml");
+        result->setProperty("bytes", (juce::int64)state->getSize());
+        result->setProperty("microsecondsPerLoad", seconds * 1.0e6 / numLoads);
+        results.add(juce::var(result));
+    }
+
+    return results;
+}
+
+juce::var Benchmarks::getMachineInfo() const
+{
+    auto* info = new juce::DynamicObject();
+    info->setProperty("cpu", juce::SystemStats::getCpuModel());
+    info->setProperty("cores", juce::SystemStats::getNumPhysicalCpus());
+    info->setProperty("simd", LaneKernels::getLevelName(LaneKernels::getCpuLevel()));
+    info->setProperty("os", juce::SystemStats::getOperatingSystemName());
+    info->setProperty("juce", juce::SystemStats::getJUCEVersion());
+    info->setProperty("time", juce::Time::getCurrentTime().toISO8601(true));
+    info->setProperty("deadline", settings.deadline);
+    info->setProperty("hardwareCounters", HardwareCounters().isAvailable());
+    return juce::var(info);
+}
+
+juce::var Benchmarks::runAll()
+{
+    auto* report = new juce::DynamicObject();
+    report->setProperty("machine", getMachineInfo());
+    report->setProperty("oscillators", runOscillators());
+    report->setProperty("filters", runFilters());
+    report->setProperty("lanes", runLaneKernels());
+    report->setProperty("voices", runVoices());
+    report->setProperty("processBlock", runProcessBlock());
+    report->setProperty("state", runStateLoading());
+    return juce::var(report);
+}
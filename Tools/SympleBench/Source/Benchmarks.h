@@ -0,0 +1,81 @@
+/*
+  ==============================================================================
+
+    Benchmarks.h
+    Created: 19 Oct 2026
+    Author:  woz
+    Notes: Micro benchmarks for the oscillator, filter and voice hot paths and
+           macro benchmarks of the whole processBlock. Every result is a json
+           object so runs can be compared by scripts.
+
+           On Linux the timed results also count instructions and memory
+           traffic per sample with the cpu's performance counters. Where the
+           counters can't be read, e.g. with a strict perf_event_paranoid or
+           on other platforms, those fields are left out.
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+struct BenchmarkSettings
+{
+    juce::Array<double> sampleRates { 44100.0, 48000.0, 88200.0, 96000.0, 192000.0 };
+    juce::Array<int> blockSizes { 32, 64, 128, 256, 512, 1024, 2048 };
+    juce::Array<int> voiceCounts { 1, 5, 16, 64 };
+    double secondsPerRun = 2.0;   // audio rendered per measurement
+    int repeats = 3;              // the fastest repeat is reported
+    double deadline = 0.5;        // fraction of a block period the synth may use
+    bool useVoiceEngine = false;
+};
+
+class Benchmarks
+{
+public:
+    explicit Benchmarks(const BenchmarkSettings& settings);
+
+    /* Oscillator::generate for every waveform */
+    juce::var runOscillators();
+
+    /* Filter<float>::process for every FilterMode, with a fixed and a moving cutoff */
+    juce::var runFilters();
+
+    /* The VoiceEngine lane kernels for every instruction set the cpu has,
+       with the largest difference of each from the scalar kernels */
+    juce::var runLaneKernels();
+
+    /* SynthVoice::renderNextBlock through note on, sustain and release, fused and unfused */
+    juce::var runVoices();
+
+    /* Full processBlock across voice counts, block sizes and sample rates */
+    juce::var runProcessBlock();
+
+    /* Restoring the binary state blob against the xml one */
+    juce::var runStateLoading();
+
+    /* Everything above plus a description of the machine */
+    juce::var runAll();
+
+    /* Checks that went over their limit so far, e.g. a lane kernel off from scalar */
+    int getNumFailures() const { return failures; }
+
+private:
+    /* Hardware counts of the fastest repeat of the last measure() */
+    struct Counters
+    {
+        bool valid = false;
+        juce::int64 instructions = 0;
+        juce::int64 cacheMisses = 0;    // last level, each one a line read from memory
+    };
+
+    BenchmarkSettings settings;
+    Counters lastCounters;
+    int failures = 0;
+
+    template <typename Function>
+    double measure(Function&& function);
+
+    juce::var makeResult(const juce::String& name, double seconds, juce::int64 numSamples) const;
+    juce::var getMachineInfo() const;
+};
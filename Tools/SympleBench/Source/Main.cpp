@@ -0,0 +1,84 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 19 Oct 2026
+    Author:  woz
+    Notes: Benchmarks for SympleSynth, results are written as json.
+
+           SympleBench [--out results.json] [options]
+
+           --only name      oscillators, filters, lanes, voices, processBlock or state
+           --quick          44.1 and 96 kHz, blocks of 64 and 512
+           --seconds s      audio rendered per measurement, default 2
+           --repeats n      runs per measurement, the fastest is kept, default 3
+           --deadline f     fraction of a block period used for voices per core, default 0.5
+           --voice-engine   run processBlock with the structure-of-arrays VoiceEngine
+
+           Build in Release, the numbers from a debug build mean nothing.
+           The exit code is the number of checks that failed, e.g. a lane
+           kernel further from the scalar one than its limit.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include <iostream>
+#include "Benchmarks.h"
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+    juce::ArgumentList args (argc, argv);
+
+    BenchmarkSettings settings;
+
+    if (args.containsOption("--quick"))
+    {
+        settings.sampleRates = { 44100.0, 96000.0 };
+        settings.blockSizes = { 64, 512 };
+    }
+    if (args.containsOption("--seconds"))
+        settings.secondsPerRun = args.getValueForOption("--seconds").getDoubleValue();
+    if (args.containsOption("--repeats"))
+        settings.repeats = args.getValueForOption("--repeats").getIntValue();
+    if (args.containsOption("--deadline"))
+        settings.deadline = args.getValueForOption("--deadline").getDoubleValue();
+    settings.useVoiceEngine = args.containsOption("--voice-engine");
+
+    Benchmarks benchmarks (settings);
+    juce::var results;
+    const auto only = args.getValueForOption("--only");
+
+    if (only.isEmpty())                results = benchmarks.runAll();
+    else if (only == "oscillators")    results = benchmarks.runOscillators();
+    else if (only == "filters")        results = benchmarks.runFilters();
+    else if (only == "lanes")          results = benchmarks.runLaneKernels();
+    else if (only == "voices")         results = benchmarks.runVoices();
+    else if (only == "processBlock")   results = benchmarks.runProcessBlock();
+    else if (only == "state")          results = benchmarks.runStateLoading();
+    else
+    {
+        std::cerr << "unknown benchmark " << only << std::endl;
+        return 1;
+    }
+
+    const auto json = juce::JSON::toString(results);
+
+    if (args.containsOption("--out"))
+    {
+        auto file = args.getFileForOption("--out");
+        if (!file.replaceWithText(json))
+        {
+            std::cerr << "could not write " << file.getFullPathName() << std::endl;
+            return 1;
+        }
+    }
+    else
+    {
+        std::cout << json << std::endl;
+    }
+
+    return benchmarks.getNumFailures();
+}
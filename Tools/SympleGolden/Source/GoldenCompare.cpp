@@ -0,0 +1,208 @@
+/*
+  ==============================================================================
+
+    GoldenCompare.cpp
+    Created: 19 Oct 2026
+    Author:  woz
+
+  ==============================================================================
+*/
+
+#include "GoldenCompare.h"
+
+namespace
+{
+    constexpr int fftOrder = 11;
+    constexpr int fftSize = 1 << fftOrder;
+    constexpr float spectrumFloorDb = -100.0f;
+    constexpr float ignoreBelowPeakDb = 80.0f; // bins this far under the peak are noise
+    constexpr int truePeakPhases = 4;
+    constexpr int truePeakTaps = 64;
+
+    /* Average magnitude spectrum in dB of all channels, hann windowed with 50% overlap */
+    std::vector<float> getAverageSpectrum(const juce::AudioBuffer<float>& buffer)
+    {
+        juce::dsp::FFT fft (fftOrder);
+        juce::dsp::WindowingFunction<float> window ((size_t)fftSize, juce::dsp::WindowingFunction<float>::hann);
+        std::vector<float> frame ((size_t)fftSize * 2);
+        std::vector<float> sum ((size_t)fftSize / 2 + 1, 0.0f);
+        int numFrames = 0;
+
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+        {
+            for (int start = 0; start + fftSize <= buffer.getNumSamples(); start += fftSize / 2)
+            {
+                std::fill(frame.begin(), frame.end(), 0.0f);
+                std::copy_n(buffer.getReadPointer(channel, start), fftSize, frame.begin());
+                window.multiplyWithWindowingTable(frame.data(), (size_t)fftSize);
+                fft.performFrequencyOnlyForwardTransform(frame.data());
+
+                for (size_t bin = 0; bin < sum.size(); ++bin)
+                    sum[bin] += frame[bin];
+                ++numFrames;
+            }
+        }
+
+        for (auto& bin : sum)
+            bin = juce::Decibels::gainToDecibels(bin / juce::jmax(1, numFrames), spectrumFloorDb);
+
+        return sum;
+    }
+
+    float getSpectralDifference(const juce::AudioBuffer<float>& reference, const juce::AudioBuffer<float>& rendered)
+    {
+        const auto a = getAverageSpectrum(reference);
+        const auto b = getAverageSpectrum(rendered);
+        const float threshold = juce::jmax(*std::max_element(a.begin(), a.end()),
+                                           *std::max_element(b.begin(), b.end())) - ignoreBelowPeakDb;
+
+        float difference = 0.0f;
+        for (size_t bin = 0; bin < a.size(); ++bin)
+            if (a[bin] > threshold || b[bin] > threshold)
+                difference = juce::jmax(difference, std::abs(a[bin] - b[bin]));
+
+        return difference;
+    }
+}
+
+float GoldenCompare::getTruePeakDb(const juce::AudioBuffer<float>& buffer)
+{
+    // a Blackman windowed sinc for each fraction between samples, the
+    // samples before and after the render are taken as silence
+    constexpr int halfTaps = truePeakTaps / 2;
+    float coefficients[truePeakPhases - 1][truePeakTaps];
+
+    for (int phase = 1; phase < truePeakPhases; ++phase)
+    {
+        const double fraction = phase / (double)truePeakPhases;
+        double sum = 0.0;
+
+        for (int tap = 0; tap < truePeakTaps; ++tap)
+        {
+            const double t = tap - halfTaps + 1 - fraction;
+            const double x = juce::MathConstants<double>::pi * t;
+            const double w = juce::MathConstants<double>::pi * t / (halfTaps + 1);
+            coefficients[phase - 1][tap] = (float)(std::sin(x) / x * (0.42 + 0.5 * std::cos(w) + 0.08 * std::cos(2.0 * w)));
+            sum += coefficients[phase - 1][tap];
+        }
+
+        for (auto& coefficient : coefficients[phase - 1])
+            coefficient = (float)(coefficient / sum);
+    }
+
+    float peak = 0.0f;
+    const int numSamples = buffer.getNumSamples();
+
+    for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+    {
+        auto* samples = buffer.getReadPointer(channel);
+
+        for (int sample = 0; sample < numSamples; ++sample)
+        {
+            peak = juce::jmax(peak, std::abs(samples[sample]));
+
+            // the points between sample and the one after it
+            const int first = sample - halfTaps + 1;
+            const int begin = juce::jmax(0, -first);
+            const int end = juce::jmin(truePeakTaps, numSamples - first);
+
+            for (auto& phase : coefficients)
+            {
+                float value = 0.0f;
+                for (int tap = begin; tap < end; ++tap)
+                    value += phase[tap] * samples[first + tap];
+
+                peak = juce::jmax(peak, std::abs(value));
+            }
+        }
+    }
+
+    return juce::Decibels::gainToDecibels(peak, -200.0f);
+}
+
+GoldenComparison GoldenCompare::compare(const juce::AudioBuffer<float>& reference,
+                                        const juce::AudioBuffer<float>& rendered,
+                                        const GoldenTolerance& tolerance)
+{
+    GoldenComparison result;
+    result.truePeakDb = getTruePeakDb(rendered);
+    result.truePeakPassed = !tolerance.checkTruePeak || result.truePeakDb <= tolerance.maxTruePeakDb;
+
+    result.lengthsMatch = reference.getNumChannels() == rendered.getNumChannels()
+                       && reference.getNumSamples() == rendered.getNumSamples();
+
+    if (!result.lengthsMatch)
+        return result;
+
+    double sumOfSquares = 0.0;
+    for (int channel = 0; channel < reference.getNumChannels(); ++channel)
+    {
+        auto* a = reference.getReadPointer(channel);
+        auto* b = rendered.getReadPointer(channel);
+
+        for (int sample = 0; sample < reference.getNumSamples(); ++sample)
+        {
+            const float error = std::abs(a[sample] - b[sample]);
+
+            if (a[sample] != b[sample] && (result.firstDifferentSample < 0 || sample < result.firstDifferentSample))
+                result.firstDifferentSample = sample;
+
+            result.maxAbsError = juce::jmax(result.maxAbsError, error);
+            sumOfSquares += (double)error * error;
+        }
+    }
+
+    const auto totalSamples = (double)reference.getNumSamples() * reference.getNumChannels();
+    result.rmsError = (float)std::sqrt(sumOfSquares / juce::jmax(1.0, totalSamples));
+    result.bitExact = result.firstDifferentSample < 0;
+    result.spectralDifferenceDb = result.bitExact ? 0.0f : getSpectralDifference(reference, rendered);
+
+    if (tolerance.bitExact)
+        result.passed = result.bitExact;
+    else
+        result.passed = result.maxAbsError <= tolerance.maxAbsError
+                     && result.spectralDifferenceDb <= tolerance.maxSpectralDifferenceDb;
+
+    result.passed = result.passed && result.truePeakPassed;
+
+    return result;
+}
+
+juce::String GoldenComparison::describe(const GoldenTolerance& tolerance) const
+{
+    juce::String text;
+    text << (passed ? "PASSED" : "FAILED") << juce::newLine;
+
+    text << "true peak:            " << juce::String(truePeakDb, 3) << " dBFS";
+    if (tolerance.checkTruePeak)
+        text << " (limit " << juce::String(tolerance.maxTruePeakDb, 3) << " dBFS)";
+    text << juce::newLine;
+
+    if (!lengthsMatch)
+        return text << "render and reference differ in length or channel count" << juce::newLine;
+
+    text << "bit exact:            " << (bitExact ? "yes" : "no") << (tolerance.bitExact ? " (required)" : "") << juce::newLine
+         << "first difference at:  " << firstDifferentSample << juce::newLine
+         << "max abs error:        " << juce::String(maxAbsError, 8) << " (limit " << juce::String(tolerance.maxAbsError, 8) << ")" << juce::newLine
+         << "max abs error dBFS:   " << juce::String(juce::Decibels::gainToDecibels(maxAbsError, -200.0f), 1) << juce::newLine
+         << "rms error:            " << juce::String(rmsError, 8) << juce::newLine
+         << "spectral difference:  " << juce::String(spectralDifferenceDb, 3) << " dB (limit "
+         << juce::String(tolerance.maxSpectralDifferenceDb, 3) << " dB)" << juce::newLine;
+
+    return text;
+}
+
+juce::var GoldenComparison::toVar() const
+{
+    auto* object = new juce::DynamicObject();
+    object->setProperty("passed", passed);
+    object->setProperty("lengthsMatch", lengthsMatch);
+    object->setProperty("bitExact", bitExact);
+    object->setProperty("maxAbsError", maxAbsError);
+    object->setProperty("rmsError", rmsError);
+    object->setProperty("spectralDifferenceDb", spectralDifferenceDb);
+    object->setProperty("firstDifferentSample", firstDifferentSample);
+    object->setProperty("truePeakDb", truePeakDb);
+    object->setProperty("truePeakPassed", truePeakPassed);
+    return juce::var(object);
+}
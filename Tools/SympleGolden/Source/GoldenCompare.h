@@ -0,0 +1,47 @@
+/*
+  ==============================================================================
+
+    GoldenCompare.h
+    Created: 19 Oct 2026
+    Author:  woz
+    Notes: Compares a render against its reference. The spectral difference
+           is taken between the average magnitude spectra of the two renders,
+           so changes that move phase but not sound (a different noise seed,
+           a reordered sum) can still pass.
+
+           True peaks are read at 4x with a 64 tap windowed sinc per phase,
+           twice the length of the limiter's own interpolator so the check
+           doesn't share its blind spots.
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "GoldenCorpus.h"
+
+struct GoldenComparison
+{
+    bool passed = false;
+    bool lengthsMatch = false;
+    bool bitExact = false;
+    float maxAbsError = 0.0f;
+    float rmsError = 0.0f;
+    float spectralDifferenceDb = 0.0f;
+    int firstDifferentSample = -1;
+    float truePeakDb = -200.0f;         // of the render
+    bool truePeakPassed = true;         // under the tolerance's limit, or not checked
+
+    juce::String describe(const GoldenTolerance& tolerance) const;
+    juce::var toVar() const;
+};
+
+namespace GoldenCompare
+{
+    GoldenComparison compare(const juce::AudioBuffer<float>& reference,
+                             const juce::AudioBuffer<float>& rendered,
+                             const GoldenTolerance& tolerance);
+
+    /* The highest 4x oversampled peak of any channel, in dBFS */
+    float getTruePeakDb(const juce::AudioBuffer<float>& buffer);
+}
@@ -0,0 +1,244 @@
+/*
+  ==============================================================================
+
+    GoldenCorpus.cpp
+    Created: 19 Oct 2026
+    Author:  woz
+
+  ==============================================================================
+*/
+
+#include "GoldenCorpus.h"
+
+namespace
+{
+    void addNote(juce::MidiMessageSequence& sequence, int note, double start, double length, float velocity = 0.8f)
+    {
+        sequence.addEvent(juce::MidiMessage::noteOn(1, note, velocity), start);
+        sequence.addEvent(juce::MidiMessage::noteOff(1, note), start + length);
+    }
+
+    juce::MidiMessageSequence makeChord(juce::Array<int> notes, double length)
+    {
+        juce::MidiMessageSequence sequence;
+        for (auto note : notes)
+            addNote(sequence, note, 0.0, length);
+        sequence.updateMatchedPairs();
+        return sequence;
+    }
+
+    /* Overlapping notes, more than the synth has voices, so voices get stolen */
+    juce::MidiMessageSequence makeRun(int numNotes, double spacing, double length)
+    {
+        juce::MidiMessageSequence sequence;
+        for (int i = 0; i < numNotes; ++i)
+            addNote(sequence, 48 + (i * 5) % 24, i * spacing, length, 0.5f + 0.05f * (i % 8));
+        sequence.updateMatchedPairs();
+        return sequence;
+    }
+
+    /* Short notes under the sustain pedal, one struck again while it still
+       rings, then the pedal lifts and a note after it releases at its note off */
+    juce::MidiMessageSequence makeSustainedRun()
+    {
+        juce::MidiMessageSequence sequence;
+        sequence.addEvent(juce::MidiMessage::controllerEvent(1, 64, 127), 0.0);
+        addNote(sequence, 48, 0.0, 0.1);
+        addNote(sequence, 55, 0.2, 0.1);
+        addNote(sequence, 64, 0.4, 0.1);
+        addNote(sequence, 48, 0.6, 0.1);
+        sequence.addEvent(juce::MidiMessage::controllerEvent(1, 64, 0), 1.0);
+        addNote(sequence, 60, 1.2, 0.2);
+        sequence.updateMatchedPairs();
+        return sequence;
+    }
+
+    GoldenTest makeTest(const juce::String& name, juce::MidiMessageSequence midi,
+                        juce::Array<std::pair<juce::String, float>> parameters)
+    {
+        GoldenTest test;
+        test.name = name;
+        test.midi = std::move(midi);
+        test.parameters = std::move(parameters);
+        test.settings.tailSeconds = 1.0;
+        test.settings.nonRealtime = false; // bounces use the Offline tier, see offline_bounce
+        return test;
+    }
+
+    /* The scalar engine test again with the widest kernels the cpu has, checked against its reference */
+    GoldenTest makeSimdTest(const GoldenTest& scalarTest)
+    {
+        auto test = scalarTest;
+        test.name = scalarTest.name + "_simd";
+        test.referenceName = scalarTest.name;
+        test.settings.maximumSimdLevel = SimdLevel::AVX512;
+        test.tolerance.maxAbsError = LaneKernels::maxDifferenceFromScalar;
+        return test;
+    }
+}
+
+juce::Array<GoldenTest> GoldenCorpus::create()
+{
+    juce::Array<GoldenTest> corpus;
+    const char* waveNames[] = { "sine", "saw", "square", "triangle" };
+
+    // each waveform on its own, filter wide open
+    for (int wave = 0; wave < 4; ++wave)
+    {
+        corpus.add(makeTest(juce::String("osc_") + waveNames[wave], makeChord({ 57 }, 1.0),
+                            { { "OSC_1_WAVE_TYPE", (float)wave }, { "OSC_2_GAIN", -120.0f },
+                              { "FILTER_1_CUTOFF", 20000.0f }, { "FILTER_2_CUTOFF", 20000.0f } }));
+    }
+
+    // both oscillators detuned against each other
+    corpus.add(makeTest("osc_detuned", makeChord({ 45, 52 }, 1.5),
+                        { { "OSC_1_WAVE_TYPE", 1.0f }, { "OSC_2_WAVE_TYPE", 2.0f },
+                          { "OSC_2_SEMITONE", 7.0f }, { "OSC_2_FINE_TUNE", 12.0f }, { "OSC_2_OCTAVE", -1.0f } }));
+
+    // every filter mode with resonance
+    for (int mode = 0; mode < 6; ++mode)
+    {
+        corpus.add(makeTest("filter_mode_" + juce::String(mode), makeChord({ 48, 55, 64 }, 1.0),
+                            { { "OSC_1_WAVE_TYPE", 1.0f }, { "FILTER_1_MODE", (float)mode }, { "FILTER_2_MODE", (float)mode },
+                              { "FILTER_1_CUTOFF", 900.0f }, { "FILTER_1_RESONANCE", 70.0f },
+                              { "FILTER_2_CUTOFF", 1800.0f }, { "FILTER_2_RESONANCE", 40.0f } }));
+    }
+
+    // filter envelopes and lfo, the modulated control rate path
+    corpus.add(makeTest("filter_envelope", makeChord({ 40, 52 }, 1.5),
+                        { { "OSC_1_WAVE_TYPE", 1.0f }, { "FILTER_1_CUTOFF", 300.0f }, { "FILTER_1_AMOUNT", 80.0f },
+                          { "FILTER_1_ATTACK", 0.2f }, { "FILTER_1_DECAY", 0.6f }, { "FILTER_1_SUSTAIN", 30.0f },
+                          { "FILTER_1_RESONANCE", 50.0f } }));
+    corpus.add(makeTest("filter_lfo", makeChord({ 45 }, 2.0),
+                        { { "OSC_1_WAVE_TYPE", 2.0f }, { "FILTER_1_CUTOFF", 600.0f }, { "LFO_AMOUNT", 60.0f },
+                          { "LFO_FREQUENCY", 3.0f }, { "LFO_WAVE_TYPE", 3.0f } }));
+
+    // amp envelope shapes, including releases that get cut by the silence threshold
+    corpus.add(makeTest("amp_envelope", makeRun(6, 0.3, 0.2),
+                        { { "AMP_ATTACK", 0.05f }, { "AMP_DECAY", 0.2f }, { "AMP_SUSTAIN", 40.0f }, { "AMP_RELEASE", 0.8f } }));
+
+    // more notes than voices, exercises stealing and the queued note events
+    corpus.add(makeTest("voice_stealing", makeRun(24, 0.05, 0.4),
+                        { { "OSC_1_WAVE_TYPE", 1.0f }, { "AMP_RELEASE", 0.5f } }));
+
+    // the same material through the structure-of-arrays engine, recorded
+    // with the scalar kernels so the reference doesn't depend on the cpu
+    {
+        auto test = makeTest("voice_engine", makeRun(24, 0.05, 0.4), { { "OSC_1_WAVE_TYPE", 1.0f }, { "AMP_RELEASE", 0.5f } });
+        test.settings.useVoiceEngine = true;
+        test.settings.maximumSimdLevel = SimdLevel::Scalar;
+        corpus.add(test);
+        corpus.add(makeSimdTest(test));
+    }
+
+    // the sustain pedal on both paths, which must hold and release the same notes
+    for (auto useVoiceEngine : { false, true })
+    {
+        auto test = makeTest(useVoiceEngine ? "voice_engine_sustain" : "sustain", makeSustainedRun(),
+                             { { "OSC_1_WAVE_TYPE", 1.0f }, { "AMP_SUSTAIN", 60.0f }, { "AMP_RELEASE", 0.3f } });
+        test.settings.useVoiceEngine = useVoiceEngine;
+        test.settings.maximumSimdLevel = SimdLevel::Scalar;
+        corpus.add(test);
+
+        if (useVoiceEngine)
+            corpus.add(makeSimdTest(test));
+    }
+
+    // block size and sample rate corners
+    {
+        auto test = makeTest("small_blocks_96k", makeRun(8, 0.1, 0.3), { { "OSC_1_WAVE_TYPE", 3.0f }, { "FILTER_1_AMOUNT", 50.0f } });
+        test.settings.sampleRate = 96000.0;
+        test.settings.blockSize = 32;
+        corpus.add(test);
+    }
+    {
+        auto test = makeTest("large_blocks", makeRun(8, 0.1, 0.3), { { "OSC_1_WAVE_TYPE", 3.0f }, { "FILTER_1_AMOUNT", 50.0f } });
+        test.settings.blockSize = 2048;
+        corpus.add(test);
+    }
+
+    // the eco and high quality tiers on modulated saws
+    corpus.add(makeTest("quality_eco", makeChord({ 40, 52 }, 1.0),
+                        { { "QUALITY", 0.0f }, { "OSC_1_WAVE_TYPE", 1.0f }, { "FILTER_1_CUTOFF", 300.0f },
+                          { "FILTER_1_AMOUNT", 80.0f }, { "FILTER_1_DECAY", 0.6f }, { "FILTER_1_SUSTAIN", 30.0f } }));
+    corpus.add(makeTest("quality_high", makeChord({ 40, 52 }, 1.0),
+                        { { "QUALITY", 2.0f }, { "OSC_1_WAVE_TYPE", 1.0f }, { "FILTER_1_CUTOFF", 300.0f },
+                          { "FILTER_1_AMOUNT", 80.0f }, { "FILTER_1_DECAY", 0.6f }, { "FILTER_1_SUSTAIN", 30.0f } }));
+
+    // a bounce: the Offline tier with the voices spread over worker threads
+    {
+        auto test = makeTest("offline_bounce", makeRun(8, 0.1, 0.3),
+                             { { "OSC_1_WAVE_TYPE", 1.0f }, { "FILTER_1_AMOUNT", 60.0f }, { "LFO_AMOUNT", 30.0f },
+                               { "LFO_FREQUENCY", 4.0f } });
+        test.settings.nonRealtime = true;
+        test.settings.voiceThreads = 3;
+        corpus.add(test);
+    }
+
+    // the master bus reverb, bounced so the tail is convolved inline
+    {
+        auto test = makeTest("reverb", makeChord({ 48, 55, 64 }, 0.5),
+                             { { "OSC_1_WAVE_TYPE", 1.0f }, { "FILTER_1_CUTOFF", 2000.0f },
+                               { "REVERB_MIX", 35.0f }, { "REVERB_SIZE", 1.5f } });
+        test.settings.nonRealtime = true;
+        test.settings.voiceThreads = 0;
+        test.settings.tailSeconds = 2.0;
+        corpus.add(test);
+    }
+
+    // chorus and tempo delay on the voice mix, at the 120 bpm used without a play head
+    {
+        auto test = makeTest("chorus-delay", makeChord({ 48, 55, 64 }, 0.5),
+                             { { "OSC_1_WAVE_TYPE", 1.0f }, { "FILTER_1_CUTOFF", 2000.0f },
+                               { "CHORUS_MIX", 50.0f }, { "CHORUS_RATE", 0.8f }, { "CHORUS_DEPTH", 60.0f },
+                               { "DELAY_MIX", 30.0f }, { "DELAY_TIME", 2.0f }, { "DELAY_FEEDBACK", 40.0f } });
+        test.settings.tailSeconds = 1.5;
+        corpus.add(test);
+    }
+
+    // every band of the master EQ away from flat
+    {
+        auto test = makeTest("eq", makeChord({ 48, 55, 64 }, 0.5),
+                             { { "OSC_1_WAVE_TYPE", 1.0f }, { "FILTER_1_CUTOFF", 6000.0f },
+                               { "EQ_LOW_GAIN", 4.0f }, { "EQ_PEAK_1_GAIN", -6.0f }, { "EQ_PEAK_2_GAIN", 3.0f },
+                               { "EQ_PEAK_2_Q", 2.0f }, { "EQ_PEAK_3_GAIN", -3.0f }, { "EQ_HIGH_GAIN", 5.0f } });
+        corpus.add(test);
+    }
+
+    // a stack loud enough to go over 0 dBFS, held under the limiter's ceiling
+    {
+        const float ceiling = -1.0f;
+        auto test = makeTest("limiter", makeChord({ 36, 43, 48, 55, 60, 64 }, 1.0),
+                             { { "OSC_1_GAIN", 0.0f }, { "OSC_2_GAIN", 0.0f }, { "MASTER_GAIN", 0.0f },
+                               { "FILTER_1_CUTOFF", 8000.0f }, { "LIMITER_CEILING", ceiling } });
+        test.tolerance.checkTruePeak = true;
+        test.tolerance.maxTruePeakDb = ceiling;
+        corpus.add(test);
+    }
+
+    // the noise oscillator is seeded from the clock, only its spectrum can be
+    // compared. The max abs error of 2.0 lets any waveform through, so this
+    // is a spectrum only check
+    {
+        auto test = makeTest("noise", makeChord({ 60 }, 1.0),
+                             { { "OSC_1_GAIN", -120.0f }, { "OSC_2_GAIN", -120.0f }, { "NOISE_1_GAIN", -12.0f },
+                               { "FILTER_1_CUTOFF", 2000.0f } });
+        test.tolerance.maxAbsError = 2.0f;
+        test.tolerance.maxSpectralDifferenceDb = 1.5f;
+        corpus.add(test);
+    }
+
+    return corpus;
+}
+
+void GoldenCorpus::applyParameters(const GoldenTest& test, SympleSynthAudioProcessor& processor)
+{
+    for (auto& parameter : test.parameters)
+    {
+        auto* target = processor.getTree().getParameter(parameter.first);
+        jassert(target != nullptr); // the corpus names a parameter that no longer exists
+
+        if (target != nullptr)
+            target->setValueNotifyingHost(target->convertTo0to1(parameter.second));
+    }
+}
@@ -0,0 +1,52 @@
+/*
+  ==============================================================================
+
+    GoldenCorpus.h
+    Created: 19 Oct 2026
+    Author:  woz
+    Notes: The fixed set of parameter states and midi sequences that every DSP
+           change is checked against. The corpus is built in code so nothing
+           but the reference renders has to be stored. Adding a test changes
+           nothing for the others, but changing one means recording its
+           reference again.
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "../../SympleRender/Source/OfflineRenderer.h"
+
+struct GoldenTolerance
+{
+    bool bitExact = false;
+    float maxAbsError = 1.0e-4f;          // largest difference of any sample
+    float maxSpectralDifferenceDb = 0.5f; // largest difference of any bin in the average spectrum
+
+    // the render itself must stay under this 4x oversampled peak, whatever
+    // the reference says, so a broken stage can't be recorded as golden
+    bool checkTruePeak = false;
+    float maxTruePeakDb = 0.0f;
+};
+
+struct GoldenTest
+{
+    juce::String name;
+    RenderSettings settings;
+    juce::Array<std::pair<juce::String, float>> parameters; // by id, in plain units
+    juce::MidiMessageSequence midi;
+    GoldenTolerance tolerance;
+
+    // when set, the test records nothing and is checked against that test's reference
+    juce::String referenceName;
+
+    juce::String getReferenceName() const { return referenceName.isEmpty() ? name : referenceName; }
+};
+
+namespace GoldenCorpus
+{
+    juce::Array<GoldenTest> create();
+
+    /* Sets the test's parameters on a freshly built processor */
+    void applyParameters(const GoldenTest& test, SympleSynthAudioProcessor& processor);
+}
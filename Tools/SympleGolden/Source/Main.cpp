@@ -0,0 +1,218 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 19 Oct 2026
+    Author:  woz
+    Notes: Golden output regression checks for SympleSynth.
+
+           SympleGolden --record references    renders the corpus as the new references
+           SympleGolden --check references --report folder
+
+           --only name      runs the tests whose name contains name
+           --list           prints the corpus
+
+           References are 32 bit float wav files named after the test. A check
+           writes <test>.txt for every test and, for failures, the render and
+           the difference against the reference as wav files, plus a summary
+           in report.json. The exit code is the number of failed tests.
+
+           The references live in Tools/SympleGolden/References and are
+           committed with the change that makes them. They are recorded from
+           a Release build of the commit before the change under test, run
+           from the repository root:
+
+               git stash
+               SympleGolden --record Tools/SympleGolden/References
+               git stash pop
+               SympleGolden --check Tools/SympleGolden/References
+
+           A checkout without the folder has to record it like this first,
+           as --check fails every test that has no reference. A change that
+           is meant to alter the sound records the folder again after
+           listening to the failed renders, and commits the new references
+           with the change.
+
+           Debug builds are compiled with SYMPLE_REALTIME_CHECKS, and a test
+           also fails if the audio thread allocated or blocked on a lock.
+
+           A test with a true peak limit fails when its render goes over it,
+           and such a render is never recorded as a reference.
+
+           The voice engine tests are recorded with the scalar kernels. Their
+           _simd copies record nothing and are checked against the scalar
+           references, within LaneKernels::maxDifferenceFromScalar.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include <iostream>
+#include "GoldenCorpus.h"
+#include "GoldenCompare.h"
+
+namespace
+{
+    juce::Array<GoldenTest> getTests(const juce::ArgumentList& args)
+    {
+        auto corpus = GoldenCorpus::create();
+
+        if (args.containsOption("--only"))
+        {
+            const auto only = args.getValueForOption("--only");
+            corpus.removeIf([&only] (const GoldenTest& test) { return !test.name.contains(only); });
+        }
+
+        return corpus;
+    }
+
+    juce::AudioBuffer<float> renderTest(const GoldenTest& test, RenderStats* stats = nullptr)
+    {
+        // a fresh processor per test, so no test depends on the ones before it
+        OfflineRenderer renderer (test.settings);
+        GoldenCorpus::applyParameters(test, renderer.getProcessor());
+
+        juce::AudioBuffer<float> output;
+        const auto renderStats = renderer.render(test.midi, output);
+        if (stats != nullptr)
+            *stats = renderStats;
+
+        return output;
+    }
+
+    bool readWavFile(const juce::File& file, juce::AudioBuffer<float>& buffer)
+    {
+        juce::WavAudioFormat format;
+        std::unique_ptr<juce::AudioFormatReader> reader (format.createReaderFor(file.createInputStream().release(), true));
+
+        if (reader == nullptr)
+            return false;
+
+        buffer.setSize((int)reader->numChannels, (int)reader->lengthInSamples);
+        return reader->read(&buffer, 0, buffer.getNumSamples(), 0, true, true);
+    }
+
+    void record(const juce::ArgumentList& args)
+    {
+        const auto folder = args.getFileForOption("--record");
+        if (!folder.createDirectory())
+            juce::ConsoleApplication::fail("could not create " + folder.getFullPathName());
+
+        for (auto& test : getTests(args))
+        {
+            if (test.referenceName.isNotEmpty())
+                continue;
+
+            const auto output = renderTest(test);
+
+            if (test.tolerance.checkTruePeak)
+            {
+                const auto truePeak = GoldenCompare::getTruePeakDb(output);
+                if (truePeak > test.tolerance.maxTruePeakDb)
+                    juce::ConsoleApplication::fail(test.name + " peaks at " + juce::String(truePeak, 3) + " dBFS, over its limit of "
+                                                   + juce::String(test.tolerance.maxTruePeakDb, 3) + ", not recorded");
+            }
+
+            if (!OfflineRenderer::writeWavFile(folder.getChildFile(test.name + ".wav"), output, test.settings.sampleRate, 32))
+                juce::ConsoleApplication::fail("could not write the reference for " + test.name);
+
+            std::cout << "recorded " << test.name << std::endl;
+        }
+    }
+
+    int check(const juce::ArgumentList& args)
+    {
+        const auto referenceFolder = args.getExistingFolderForOption("--check");
+        const auto reportFolder = args.containsOption("--report") ? args.getFileForOption("--report")
+                                                                  : referenceFolder.getChildFile("report");
+        if (!reportFolder.createDirectory())
+            juce::ConsoleApplication::fail("could not create " + reportFolder.getFullPathName());
+
+        juce::Array<juce::var> summary;
+        int failures = 0;
+
+        for (auto& test : getTests(args))
+        {
+            juce::AudioBuffer<float> reference;
+            if (!readWavFile(referenceFolder.getChildFile(test.getReferenceName() + ".wav"), reference))
+            {
+                std::cout << test.name << ": no reference, record one with --record" << std::endl;
+                ++failures;
+                continue;
+            }
+
+            RenderStats stats;
+            const auto rendered = renderTest(test, &stats);
+            auto comparison = GoldenCompare::compare(reference, rendered, test.tolerance);
+
+            // a debug build also fails a test whose render broke realtime rules
+            if (stats.realtimeViolations > 0)
+            {
+                comparison.passed = false;
+                std::cout << test.name << ": " << stats.realtimeViolations << " realtime violations" << std::endl;
+            }
+
+            if (!comparison.truePeakPassed)
+                std::cout << test.name << ": true peak " << juce::String(comparison.truePeakDb, 3)
+                          << " dBFS over the limit" << std::endl;
+
+            reportFolder.getChildFile(test.name + ".txt").replaceWithText(test.name + juce::newLine + comparison.describe(test.tolerance));
+
+            if (!comparison.passed)
+            {
+                ++failures;
+                OfflineRenderer::writeWavFile(reportFolder.getChildFile(test.name + ".rendered.wav"), rendered, test.settings.sampleRate, 32);
+
+                if (comparison.lengthsMatch)
+                {
+                    juce::AudioBuffer<float> difference;
+                    difference.makeCopyOf(rendered);
+                    for (int channel = 0; channel < difference.getNumChannels(); ++channel)
+                        difference.addFrom(channel, 0, reference, channel, 0, difference.getNumSamples(), -1.0f);
+
+                    OfflineRenderer::writeWavFile(reportFolder.getChildFile(test.name + ".diff.wav"), difference, test.settings.sampleRate, 32);
+                }
+            }
+
+            auto result = comparison.toVar();
+            result.getDynamicObject()->setProperty("name", test.name);
+            summary.add(result);
+
+            std::cout << test.name << ": " << (comparison.passed ? "passed" : "FAILED")
+                      << (comparison.bitExact ? " (bit exact)" : "") << std::endl;
+        }
+
+        reportFolder.getChildFile("report.json").replaceWithText(juce::JSON::toString(summary));
+        std::cout << summary.size() << " tests, " << failures << " failed" << std::endl;
+        return failures;
+    }
+}
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+    juce::ArgumentList args (argc, argv);
+
+    return juce::ConsoleApplication::invokeCatchingFailures([&args]
+    {
+        if (args.containsOption("--list"))
+        {
+            for (auto& test : getTests(args))
+                std::cout << test.name << std::endl;
+            return 0;
+        }
+
+        if (args.containsOption("--record"))
+        {
+            record(args);
+            return 0;
+        }
+
+        if (args.containsOption("--check"))
+            return check(args);
+
+        std::cout << "Usage: SympleGolden --record folder | --check folder [--report folder] [--only name]" << std::endl;
+        return 1;
+    });
+}
@@ -0,0 +1,238 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 19 Oct 2026
+    Author:  woz
+    Notes: Headless renderer for SympleSynth.
+
+           SympleRender --midi song.mid --out song.wav [options]
+           SympleRender --batch folder --outdir stems [--jobs n] [options]
+
+           --state file     state blob saved by the plugin (getStateInformation)
+           --write-state f  writes the default state blob to f and exits
+           --rate hz        sample rate, default 44100
+           --block n        block size, default 512
+           --tail s         seconds rendered after the last event, default 2
+           --bits n         wav bit depth, default 24
+           --realtime       render as a live host would instead of bouncing
+           --voice-threads n  threads a bounce renders voices on, default
+                            one per core, or none in batch mode
+           --voice-engine   use the structure-of-arrays VoiceEngine
+           --simd level     cap its kernels at scalar, sse2, avx2 or avx512
+
+           Batch mode renders every .mid file in the folder, one processor per
+           worker thread, and prints the real time factor of each file.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include <iostream>
+#include "OfflineRenderer.h"
+
+namespace
+{
+    RenderSettings parseSettings(const juce::ArgumentList& args)
+    {
+        RenderSettings settings;
+
+        if (args.containsOption("--rate"))
+            settings.sampleRate = args.getValueForOption("--rate").getDoubleValue();
+        if (args.containsOption("--block"))
+            settings.blockSize = args.getValueForOption("--block").getIntValue();
+        if (args.containsOption("--tail"))
+            settings.tailSeconds = args.getValueForOption("--tail").getDoubleValue();
+
+        settings.nonRealtime = !args.containsOption("--realtime");
+        settings.useVoiceEngine = args.containsOption("--voice-engine");
+
+        if (args.containsOption("--voice-threads"))
+            settings.voiceThreads = args.getValueForOption("--voice-threads").getIntValue();
+
+        if (args.containsOption("--simd") && !LaneKernels::parseLevel(args.getValueForOption("--simd"), settings.maximumSimdLevel))
+            juce::ConsoleApplication::fail("unknown simd level " + args.getValueForOption("--simd"));
+
+        if (settings.sampleRate < 8000.0 || settings.blockSize < 1)
+            juce::ConsoleApplication::fail("invalid sample rate or block size");
+
+        return settings;
+    }
+
+    juce::MemoryBlock loadState(const juce::ArgumentList& args)
+    {
+        juce::MemoryBlock state;
+
+        if (args.containsOption("--state"))
+        {
+            auto file = args.getExistingFileForOption("--state");
+            if (!file.loadFileAsData(state))
+                juce::ConsoleApplication::fail("could not read " + file.getFullPathName());
+        }
+
+        return state;
+    }
+
+    int getBitDepth(const juce::ArgumentList& args)
+    {
+        return args.containsOption("--bits") ? args.getValueForOption("--bits").getIntValue() : 24;
+    }
+
+    struct RenderJob
+    {
+        juce::File midiFile;
+        juce::File outputFile;
+        RenderStats stats;
+        bool succeeded = false;
+    };
+
+    bool renderJob(OfflineRenderer& renderer, RenderJob& job, int bitsPerSample)
+    {
+        juce::MidiMessageSequence sequence;
+        if (!OfflineRenderer::readMidiFile(job.midiFile, sequence))
+            return false;
+
+        juce::AudioBuffer<float> output;
+        job.stats = renderer.render(sequence, output);
+
+        return OfflineRenderer::writeWavFile(job.outputFile, output, renderer.getSettings().sampleRate, bitsPerSample);
+    }
+
+    /* Pulls jobs off a shared list until there are none left */
+    class RenderWorker : public juce::Thread
+    {
+    public:
+        RenderWorker(const RenderSettings& settings, const juce::MemoryBlock& state,
+                     std::vector<RenderJob>& j, std::atomic<int>& next, int bits)
+            : juce::Thread("SympleRender worker"), renderer(settings), jobs(j), nextJob(next), bitsPerSample(bits)
+        {
+            if (state.getSize() > 0)
+                renderer.loadState(state);
+        }
+
+        void run() override
+        {
+            for (int index = nextJob++; index < (int)jobs.size() && !threadShouldExit(); index = nextJob++)
+                jobs[(size_t)index].succeeded = renderJob(renderer, jobs[(size_t)index], bitsPerSample);
+        }
+
+    private:
+        OfflineRenderer renderer;
+        std::vector<RenderJob>& jobs;
+        std::atomic<int>& nextJob;
+        int bitsPerSample;
+    };
+
+    void renderSingle(const juce::ArgumentList& args)
+    {
+        const auto settings = parseSettings(args);
+        const auto state = loadState(args);
+
+        RenderJob job;
+        job.midiFile = args.getExistingFileForOption("--midi");
+        job.outputFile = args.getFileForOption("--out");
+
+        OfflineRenderer renderer(settings);
+        if (state.getSize() > 0)
+            renderer.loadState(state);
+
+        if (!renderJob(renderer, job, getBitDepth(args)))
+            juce::ConsoleApplication::fail("could not render " + job.midiFile.getFullPathName());
+
+        std::cout << job.outputFile.getFileName() << ": " << job.stats.toString(settings) << std::endl;
+    }
+
+    void renderBatch(const juce::ArgumentList& args)
+    {
+        // the files already keep every core busy
+        auto settings = parseSettings(args);
+        if (!args.containsOption("--voice-threads"))
+            settings.voiceThreads = 0;
+
+        const auto state = loadState(args);
+        const auto folder = args.getExistingFolderForOption("--batch");
+        const auto outputFolder = args.getFileForOption("--outdir");
+
+        if (!outputFolder.createDirectory())
+            juce::ConsoleApplication::fail("could not create " + outputFolder.getFullPathName());
+
+        std::vector<RenderJob> jobs;
+        for (auto& midiFile : folder.findChildFiles(juce::File::findFiles, false, "*.mid;*.midi"))
+        {
+            RenderJob job;
+            job.midiFile = midiFile;
+            job.outputFile = outputFolder.getChildFile(midiFile.getFileNameWithoutExtension() + ".wav");
+            jobs.push_back(job);
+        }
+
+        int numWorkers = args.containsOption("--jobs") ? args.getValueForOption("--jobs").getIntValue()
+                                                       : juce::SystemStats::getNumCpus();
+        numWorkers = juce::jlimit(1, juce::jmax(1, (int)jobs.size()), numWorkers);
+
+        // processors are built here on the message thread, then handed to the workers
+        std::atomic<int> nextJob { 0 };
+        juce::OwnedArray<RenderWorker> workers;
+        for (int i = 0; i < numWorkers; ++i)
+            workers.add(new RenderWorker(settings, state, jobs, nextJob, getBitDepth(args)));
+
+        const auto start = juce::Time::getMillisecondCounterHiRes();
+        for (auto* worker : workers)
+            worker->startThread();
+        for (auto* worker : workers)
+            worker->waitForThreadToExit(-1);
+        const double wallSeconds = (juce::Time::getMillisecondCounterHiRes() - start) * 0.001;
+
+        double audioSeconds = 0.0;
+        int failures = 0;
+        for (auto& job : jobs)
+        {
+            if (job.succeeded)
+            {
+                std::cout << job.outputFile.getFileName() << ": " << job.stats.toString(settings) << std::endl;
+                audioSeconds += job.stats.audioSeconds;
+            }
+            else
+            {
+                std::cout << job.midiFile.getFileName() << ": FAILED" << std::endl;
+                ++failures;
+            }
+        }
+
+        std::cout << jobs.size() << " files, " << numWorkers << " workers, "
+                  << juce::String(audioSeconds, 1) << " s audio in " << juce::String(wallSeconds, 2) << " s, "
+                  << juce::String(wallSeconds > 0.0 ? audioSeconds / wallSeconds : 0.0, 1) << "x real time" << std::endl;
+
+        if (failures > 0)
+            juce::ConsoleApplication::fail(juce::String(failures) + " files failed");
+    }
+
+    void writeDefaultState(const juce::ArgumentList& args)
+    {
+        OfflineRenderer renderer(RenderSettings {});
+        juce::MemoryBlock state;
+        renderer.getProcessor().getStateInformation(state);
+
+        auto file = args.getFileForOption("--write-state");
+        if (!file.replaceWithData(state.getData(), state.getSize()))
+            juce::ConsoleApplication::fail("could not write " + file.getFullPathName());
+    }
+}
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    // the processor's parameters need a message manager, even without an editor
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::ConsoleApplication app;
+    app.addHelpCommand("--help|-h", "Usage: SympleRender --midi in.mid --out out.wav [--state blob] [--rate hz] [--block n]\n"
+                                    "       SympleRender --batch folder --outdir folder [--jobs n]", true);
+    app.addCommand({ "--batch", "--batch folder --outdir folder", "Renders every midi file in a folder in parallel", {},
+                     [] (const auto& args) { renderBatch(args); } });
+    app.addCommand({ "--write-state", "--write-state file", "Writes the default state blob", {},
+                     [] (const auto& args) { writeDefaultState(args); } });
+    app.addCommand({ "--midi", "--midi in.mid --out out.wav", "Renders one midi file", {},
+                     [] (const auto& args) { renderSingle(args); } });
+
+    return app.findAndRunCommand(argc, argv);
+}
@@ -0,0 +1,174 @@
+/*
+  ==============================================================================
+
+    OfflineRenderer.cpp
+    Created: 19 Oct 2026
+    Author:  woz
+
+  ==============================================================================
+*/
+
+#include "OfflineRenderer.h"
+
+juce::String RenderStats::toString(const RenderSettings& settings) const
+{
+    return juce::String(audioSeconds, 2) + " s audio in " + juce::String(renderSeconds, 3)
+         + " s, " + juce::String(getRealTimeFactor(), 1) + "x real time, "
+         + juce::String(numBlocks) + " blocks, peak block load "
+         + juce::String(getPeakBlockLoad(settings) * 100.0, 1) + "%"
+         + (realtimeViolations > 0 ? ", " + juce::String(realtimeViolations) + " realtime violations" : juce::String());
+}
+
+OfflineRenderer::OfflineRenderer(const RenderSettings& s)
+    : settings(s)
+{
+    processor.setVoiceEngineEnabled(settings.useVoiceEngine);
+    processor.setMaximumSimdLevel(settings.maximumSimdLevel);
+    processor.setOfflineRenderThreads(settings.voiceThreads);
+    processor.getBlockTimeMonitor().stopDumping(); // renders report their own timings
+    prepare();
+}
+
+OfflineRenderer::~OfflineRenderer()
+{
+    processor.releaseResources();
+}
+
+void OfflineRenderer::prepare()
+{
+    const int numChannels = processor.getTotalNumOutputChannels();
+
+    processor.setNonRealtime(settings.nonRealtime);
+    processor.setRateAndBufferSizeDetails(settings.sampleRate, settings.blockSize);
+    processor.prepareToPlay(settings.sampleRate, settings.blockSize);
+
+    blockBuffer.setSize(numChannels, settings.blockSize);
+    midiBuffer.ensureSize(4096);
+}
+
+void OfflineRenderer::loadState(const juce::MemoryBlock& state)
+{
+    processor.setStateInformation(state.getData(), (int)state.getSize());
+}
+
+/*
+ *  Calls processBlock under the callback lock like a host does and returns the
+ *  time it took. blockBuffer and midiBuffer have to be filled by the caller.
+ */
+double OfflineRenderer::processNextBlock(int numSamples)
+{
+    blockBuffer.setSize(blockBuffer.getNumChannels(), numSamples, false, false, true);
+
+    const juce::ScopedLock sl (processor.getCallbackLock());
+    const auto start = juce::Time::getHighResolutionTicks();
+    processor.processBlock(blockBuffer, midiBuffer);
+    const auto end = juce::Time::getHighResolutionTicks();
+
+    return juce::Time::highResolutionTicksToSeconds(end - start);
+}
+
+RenderStats OfflineRenderer::render(const juce::MidiMessageSequence& sequence, juce::AudioBuffer<float>& output)
+{
+    // every render starts from silence so batch jobs don't bleed into each other
+    processor.reset();
+
+    const int totalSamples = (int)std::ceil((sequence.getEndTime() + settings.tailSeconds) * settings.sampleRate);
+    output.setSize(blockBuffer.getNumChannels(), totalSamples);
+
+    RenderStats stats;
+    int eventIndex = 0;
+    RealtimeChecks::resetViolations();
+
+    for (int position = 0; position < totalSamples; position += settings.blockSize)
+    {
+        const int numSamples = juce::jmin(settings.blockSize, totalSamples - position);
+
+        midiBuffer.clear();
+        while (eventIndex < sequence.getNumEvents())
+        {
+            const auto& message = sequence.getEventPointer(eventIndex)->message;
+            const int samplePosition = juce::roundToInt(message.getTimeStamp() * settings.sampleRate);
+
+            if (samplePosition >= position + numSamples)
+                break;
+
+            if (!message.isMetaEvent())
+                midiBuffer.addEvent(message, juce::jmax(0, samplePosition - position));
+
+            ++eventIndex;
+        }
+
+        const double seconds = processNextBlock(numSamples);
+        stats.renderSeconds += seconds;
+        stats.maxBlockSeconds = juce::jmax(stats.maxBlockSeconds, seconds);
+        ++stats.numBlocks;
+
+        for (int channel = 0; channel < output.getNumChannels(); ++channel)
+            output.copyFrom(channel, position, blockBuffer, channel, 0, numSamples);
+    }
+
+    stats.audioSeconds = totalSamples / settings.sampleRate;
+    stats.realtimeViolations = RealtimeChecks::getNumViolations();
+    return stats;
+}
+
+RenderStats OfflineRenderer::renderSilence(int numSamples)
+{
+    RenderStats stats;
+    RealtimeChecks::resetViolations();
+
+    for (int position = 0; position < numSamples; position += settings.blockSize)
+    {
+        midiBuffer.clear();
+        const double seconds = processNextBlock(juce::jmin(settings.blockSize, numSamples - position));
+        stats.renderSeconds += seconds;
+        stats.maxBlockSeconds = juce::jmax(stats.maxBlockSeconds, seconds);
+        ++stats.numBlocks;
+    }
+
+    stats.audioSeconds = numSamples / settings.sampleRate;
+    stats.realtimeViolations = RealtimeChecks::getNumViolations();
+    return stats;
+}
+
+/*
+ *  Merges every track into one sequence with timestamps in seconds, so tempo
+ *  changes in the file are honoured.
+ */
+bool OfflineRenderer::readMidiFile(const juce::File& file, juce::MidiMessageSequence& sequence)
+{
+    juce::FileInputStream stream(file);
+    juce::MidiFile midiFile;
+
+    if (!stream.openedOk() || !midiFile.readFrom(stream))
+        return false;
+
+    midiFile.convertTimestampTicksToSeconds();
+
+    sequence.clear();
+    for (int track = 0; track < midiFile.getNumTracks(); ++track)
+        sequence.addSequence(*midiFile.getTrack(track), 0.0);
+
+    sequence.sort();
+    return true;
+}
+
+bool OfflineRenderer::writeWavFile(const juce::File& file, const juce::AudioBuffer<float>& buffer,
+                                   double sampleRate, int bitsPerSample)
+{
+    file.deleteFile();
+    auto stream = std::make_unique<juce::FileOutputStream>(file);
+
+    if (!stream->openedOk())
+        return false;
+
+    juce::WavAudioFormat format;
+    std::unique_ptr<juce::AudioFormatWriter> writer (format.createWriterFor(stream.get(), sampleRate,
+        (unsigned int)buffer.getNumChannels(), bitsPerSample, {}, 0));
+
+    if (writer == nullptr)
+        return false;
+
+    stream.release(); // the writer owns the stream now
+    return writer->writeFromAudioSampleBuffer(buffer, 0, buffer.getNumSamples());
+}
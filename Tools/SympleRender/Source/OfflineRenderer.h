@@ -0,0 +1,82 @@
+/*
+  ==============================================================================
+
+    OfflineRenderer.h
+    Created: 19 Oct 2026
+    Author:  woz
+    Notes: Drives SympleSynthAudioProcessor without a host. A MIDI sequence is
+           fed through processBlock one block at a time, exactly the way a
+           host would, and the time spent in each block is measured.
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "../../../Source/PluginProcessor.h"
+
+struct RenderSettings
+{
+    double sampleRate = 44100.0;
+    int blockSize = 512;
+    double tailSeconds = 2.0;   // rendered after the last midi event so releases can finish
+    bool nonRealtime = true;    // bounce mode, pass false to render as a live host would
+    bool useVoiceEngine = false;
+    SimdLevel maximumSimdLevel = SimdLevel::AVX512; // the widest the cpu supports
+    int voiceThreads = -1;      // worker threads of a non-realtime render, -1 for one per core
+};
+
+struct RenderStats
+{
+    double audioSeconds = 0.0;
+    double renderSeconds = 0.0;
+    double maxBlockSeconds = 0.0;
+    int numBlocks = 0;
+    int realtimeViolations = 0; // only counted in builds with SYMPLE_REALTIME_CHECKS
+
+    /* How many times faster than real time the render ran */
+    double getRealTimeFactor() const { return renderSeconds > 0.0 ? audioSeconds / renderSeconds : 0.0; }
+
+    /* The slowest block as a fraction of the time it had available */
+    double getPeakBlockLoad(const RenderSettings& settings) const
+    {
+        return maxBlockSeconds * settings.sampleRate / settings.blockSize;
+    }
+
+    juce::String toString(const RenderSettings& settings) const;
+};
+
+class OfflineRenderer
+{
+public:
+    /* Processors start timers when they are built, so create renderers on the main thread */
+    explicit OfflineRenderer(const RenderSettings& settings);
+    ~OfflineRenderer();
+
+    /* Restores a blob written by getStateInformation */
+    void loadState(const juce::MemoryBlock& state);
+
+    /* Renders the sequence (timestamps in seconds) into output, which is resized to fit */
+    RenderStats render(const juce::MidiMessageSequence& sequence, juce::AudioBuffer<float>& output);
+
+    /* Carries on rendering with no new midi, used to time notes that are already sounding */
+    RenderStats renderSilence(int numSamples);
+
+    SympleSynthAudioProcessor& getProcessor() { return processor; }
+    const RenderSettings& getSettings() const { return settings; }
+
+    static bool readMidiFile(const juce::File& file, juce::MidiMessageSequence& sequence);
+    static bool writeWavFile(const juce::File& file, const juce::AudioBuffer<float>& buffer,
+                             double sampleRate, int bitsPerSample = 24);
+
+private:
+    RenderSettings settings;
+    SympleSynthAudioProcessor processor;
+    juce::AudioBuffer<float> blockBuffer;
+    juce::MidiBuffer midiBuffer;
+
+    void prepare();
+    double processNextBlock(int numSamples);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OfflineRenderer)
+};
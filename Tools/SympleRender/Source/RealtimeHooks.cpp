@@ -0,0 +1,170 @@
+/*
+  ==============================================================================
+
+    RealtimeHooks.cpp
+    Created: 19 Oct 2026
+    Author:  woz
+    Notes: Replaces the global allocation functions, and with glibc also
+           malloc and pthread_mutex_lock, so RealtimeChecks can see them. Only
+           linked into the console tools, a plugin must never replace its
+           host's allocator.
+
+           The full set of hooks needs the tools' Linux exporter. The Xcode
+           and Visual Studio builds only check operator new/delete, so a
+           malloc or calloc made straight from the audio thread, such as a
+           juce::HeapBlock allocation, is only caught on Linux.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../../../Source/RealtimeChecks.h"
+
+#if SYMPLE_REALTIME_CHECKS
+
+#include <new>
+#include <cstdlib>
+
+#if JUCE_LINUX && defined (__GLIBC__)
+ #include <pthread.h>
+ #include <dlfcn.h>
+
+extern "C" void* __libc_malloc (size_t);
+extern "C" void* __libc_calloc (size_t, size_t);
+extern "C" void* __libc_realloc (void*, size_t);
+extern "C" void  __libc_free (void*);
+
+ #define SYMPLE_HOOK_MALLOC 1
+#else
+ #define SYMPLE_HOOK_MALLOC 0
+#endif
+
+namespace
+{
+    // set while operator new or delete is calling down into malloc, so one
+    // allocation is reported once
+    thread_local bool inOperatorNew = false;
+
+    void* allocate(std::size_t size, const char* function)
+    {
+        if (RealtimeChecks::isInRealtimeScope())
+            RealtimeChecks::report(RealtimeChecks::Violation::Allocation, function);
+
+        inOperatorNew = true;
+        void* pointer = std::malloc(size == 0 ? 1 : size);
+        inOperatorNew = false;
+
+        if (pointer == nullptr)
+            throw std::bad_alloc();
+
+        return pointer;
+    }
+
+    void deallocate(void* pointer, const char* function) noexcept
+    {
+        if (pointer != nullptr && RealtimeChecks::isInRealtimeScope())
+            RealtimeChecks::report(RealtimeChecks::Violation::Deallocation, function);
+
+        inOperatorNew = true;
+        std::free(pointer);
+        inOperatorNew = false;
+    }
+}
+
+void* operator new (std::size_t size)                               { return allocate(size, "operator new"); }
+void* operator new[] (std::size_t size)                             { return allocate(size, "operator new[]"); }
+void* operator new (std::size_t size, const std::nothrow_t&) noexcept
+{
+    try { return allocate(size, "operator new"); } catch (...) { return nullptr; }
+}
+void* operator new[] (std::size_t size, const std::nothrow_t&) noexcept
+{
+    try { return allocate(size, "operator new[]"); } catch (...) { return nullptr; }
+}
+
+void operator delete (void* pointer) noexcept                       { deallocate(pointer, "operator delete"); }
+void operator delete[] (void* pointer) noexcept                     { deallocate(pointer, "operator delete[]"); }
+void operator delete (void* pointer, std::size_t) noexcept          { deallocate(pointer, "operator delete"); }
+void operator delete[] (void* pointer, std::size_t) noexcept        { deallocate(pointer, "operator delete[]"); }
+
+#if SYMPLE_HOOK_MALLOC
+
+namespace
+{
+    bool shouldReportMalloc() noexcept
+    {
+        return !inOperatorNew && RealtimeChecks::isInRealtimeScope();
+    }
+
+    /* glibc 2.34 moved libpthread into libc and dropped __pthread_mutex_lock
+       from the link time symbols, so the real function is looked up the
+       first time it is needed. The atomic is constant initialised, a static
+       with a guard could end up back in here */
+    int callNextMutexLock(pthread_mutex_t* mutex)
+    {
+        using LockFunction = int (*) (pthread_mutex_t*);
+        static std::atomic<LockFunction> nextMutexLock { nullptr };
+
+        auto function = nextMutexLock.load(std::memory_order_acquire);
+        if (function == nullptr)
+        {
+            function = reinterpret_cast<LockFunction>(dlsym(RTLD_NEXT, "pthread_mutex_lock"));
+            nextMutexLock.store(function, std::memory_order_release);
+        }
+
+        return function(mutex);
+    }
+}
+
+extern "C" void* malloc (size_t size)
+{
+    if (shouldReportMalloc())
+        RealtimeChecks::report(RealtimeChecks::Violation::Allocation, "malloc");
+    return __libc_malloc(size);
+}
+
+extern "C" void* calloc (size_t count, size_t size)
+{
+    if (shouldReportMalloc())
+        RealtimeChecks::report(RealtimeChecks::Violation::Allocation, "calloc");
+    return __libc_calloc(count, size);
+}
+
+extern "C" void* realloc (void* pointer, size_t size)
+{
+    if (shouldReportMalloc())
+        RealtimeChecks::report(RealtimeChecks::Violation::Allocation, "realloc");
+    return __libc_realloc(pointer, size);
+}
+
+extern "C" void free (void* pointer)
+{
+    if (pointer != nullptr && shouldReportMalloc())
+        RealtimeChecks::report(RealtimeChecks::Violation::Deallocation, "free");
+    __libc_free(pointer);
+}
+
+/*
+ *  A lock that is free is taken without waiting, which only counts as a
+ *  violation with strict locking. A lock held by another thread would block
+ *  the audio thread, so that is always reported.
+ */
+extern "C" int pthread_mutex_lock (pthread_mutex_t* mutex)
+{
+    if (RealtimeChecks::isInRealtimeScope())
+    {
+        if (pthread_mutex_trylock(mutex) == 0)
+        {
+            if (RealtimeChecks::isStrictLocking())
+                RealtimeChecks::report(RealtimeChecks::Violation::Lock, "pthread_mutex_lock");
+            return 0;
+        }
+
+        RealtimeChecks::report(RealtimeChecks::Violation::ContendedLock, "pthread_mutex_lock");
+    }
+
+    return callNextMutexLock(mutex);
+}
+
+#endif
+#endif